@@ -13,28 +13,33 @@
 
 UIndicatorComponent::UIndicatorComponent()
 {
-	IndicatorViewModel = CreateDefaultSubobject<UBaseIndicatorViewModel>(TEXT("IndicatorViewModel"));
 }
 
 void UIndicatorComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+#if !UE_SERVER
 	if (bAddIndicatorOnBegin)
 	{
 		AddIndicator(bAutoVisible);
 	}
+#endif
 }
 
 void UIndicatorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+#if !UE_SERVER
 	RemoveIndicator();
+#endif
 	Super::EndPlay(EndPlayReason);
 }
 
 void UIndicatorComponent::Deactivate()
 {
+#if !UE_SERVER
 	SetIndicatorVisibility(false);
+#endif
 	Super::Deactivate();
 }
 
@@ -42,79 +47,171 @@ void UIndicatorComponent::PostLoad()
 {
 	Super::PostLoad();
 
-	if (IndicatorViewModel)
+#if WITH_EDITORONLY_DATA
+	MigrateDeprecatedViewModel();
+#endif
+
+	UE_LOG(LogUIIndicatorPanel, Verbose, TEXT("%hs: This %s, IndicatorViewModel Class: %s, IndicatorConfig: %s"), __FUNCTION__, *GetNameSafe(this),
+		*GetNameSafe(IndicatorViewModelClass), *GetNameSafe(IndicatorConfig));
+}
+
+#if WITH_EDITORONLY_DATA
+void UIndicatorComponent::MigrateDeprecatedViewModel()
+{
+	if (!IndicatorViewModel_DEPRECATED)
+	{
+		return;
+	}
+
+	// Its own settings have to be moved to a config first
+	IndicatorViewModel_DEPRECATED->ConditionalPostLoad();
+
+	if (!IndicatorViewModelClass)
+	{
+		IndicatorViewModelClass = IndicatorViewModel_DEPRECATED->GetClass();
+	}
+
+	const UIndicatorConfigData* ViewModelConfig = IndicatorViewModel_DEPRECATED->IndicatorConfig;
+	if (!IndicatorConfig && ViewModelConfig)
+	{
+		// A config migrated from the view model's own settings lives in it, it has to move to the component to be saved without it
+		if (ViewModelConfig->GetOuter() == IndicatorViewModel_DEPRECATED)
+		{
+			const_cast<UIndicatorConfigData*>(ViewModelConfig)->Rename(nullptr, this, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+		}
+		IndicatorConfig = ViewModelConfig;
+	}
+
+	UE_LOG(LogUIIndicatorPanel, Log, TEXT("%hs %s migrated its view model %s to class %s, config %s"), __FUNCTION__, *GetPathName(), *IndicatorViewModel_DEPRECATED->GetName(),
+		*GetNameSafe(IndicatorViewModelClass), *GetNameSafe(IndicatorConfig));
+
+	// Not saved anymore, so components stop carrying a view model of their own
+	IndicatorViewModel_DEPRECATED->SetFlags(RF_Transient);
+	IndicatorViewModel_DEPRECATED = nullptr;
+}
+#endif
+
+UBaseIndicatorViewModel* UIndicatorComponent::GetOrCreateIndicatorViewModel()
+{
+#if UE_SERVER
+	return nullptr;
+#else
+	if (IndicatorViewModelInstance)
+	{
+		return IndicatorViewModelInstance;
+	}
+
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		return nullptr;
+	}
+
+	const UClass* ViewModelClass = IndicatorViewModelClass ? IndicatorViewModelClass.Get() : UBaseIndicatorViewModel::StaticClass();
+	IndicatorViewModelInstance = NewObject<UBaseIndicatorViewModel>(this, ViewModelClass, NAME_None, RF_Transient);
+
+	if (IndicatorConfig)
 	{
-		const FString ClassName = GetNameSafe(IndicatorViewModel->GetClass());
-		UE_LOG(LogUIIndicatorPanel, Log, TEXT("%hs: This %s, IndicatorViewModel Class: %s"), __FUNCTION__, *GetNameSafe(this), *ClassName);
+		IndicatorViewModelInstance->SetIndicatorConfig(IndicatorConfig);
 	}
+
+	return IndicatorViewModelInstance;
+#endif
 }
 
 void UIndicatorComponent::AddIndicator(bool bMakeVisible)
 {
+#if !UE_SERVER
 	if (bAddedIndicator)
 	{
 		return;
 	}
 
-	IndicatorViewModel->SetActorAttachedTo(GetOwner());
+	UIndicatorManagerSubsystem* IndicatorManager = GeneralHelper::GetLocalPlayerSubsystem<UIndicatorManagerSubsystem>(this);
+	if (!IndicatorManager)
+	{
+		UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%s : Indicator could not be added to UIndicatorManagerSubsystem"), *FString(__FUNCTION__));
+		return;
+	}
 
-	if (UIndicatorManagerSubsystem* IndicatorManager = GeneralHelper::GetLocalPlayerSubsystem<UIndicatorManagerSubsystem>(this))
+	UBaseIndicatorViewModel* ViewModel = GetOrCreateIndicatorViewModel();
+	if (!ViewModel)
 	{
-		IndicatorManager->AddIndicator(IndicatorViewModel);
-		bAddedIndicator = true;
-		Activate(false);
+		return;
+	}
 
-		IndicatorViewModel->Init();
-		if (IndicatorViewModel->GetHasVisibilityRange())
-		{
-			SetIndicatorVisibility(false);
-		}
-		else
-		{
-			SetIndicatorVisibility(bMakeVisible);
-		}
+	ViewModel->SetActorAttachedTo(GetOwner());
+
+	IndicatorManager->AddIndicator(ViewModel);
+	bAddedIndicator = true;
+	Activate(false);
+
+	ViewModel->Init();
+	if (ViewModel->GetHasVisibilityRange())
+	{
+		SetIndicatorVisibility(false);
 	}
 	else
 	{
-		UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%s : Indicator could not be added to UIndicatorManagerSubsystem"), *FString(__FUNCTION__));
+		SetIndicatorVisibility(bMakeVisible);
 	}
+#endif
 }
 
 void UIndicatorComponent::RemoveIndicator()
 {
+#if !UE_SERVER
 	if (bAddedIndicator)
 	{
 		if (UIndicatorManagerSubsystem* IndicatorManager = GeneralHelper::GetLocalPlayerSubsystem<UIndicatorManagerSubsystem>(this))
 		{
-			IndicatorManager->RemoveIndicator(IndicatorViewModel);
+			IndicatorManager->RemoveIndicator(IndicatorViewModelInstance);
 			bAddedIndicator = false;
 		}
 		else
 		{
-			UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%s Can't remove indicator %s because IndicatorManager is nullptr"), *FString(__FUNCTION__), *GetNameSafe(IndicatorViewModel));
+			UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%s Can't remove indicator %s because IndicatorManager is nullptr"), *FString(__FUNCTION__), *GetNameSafe(IndicatorViewModelInstance));
 		}
 
-		if (IndicatorViewModel)
+		if (IndicatorViewModelInstance)
 		{
-			IndicatorViewModel->ResetActorAttachedTo();
+			IndicatorViewModelInstance->ResetActorAttachedTo();
 		}
 	}
+#endif
 }
 
 void UIndicatorComponent::SetIndicatorVisibility(bool bInVisibility, EIndicatorVisibilityPriority InPriority)
 {
-	if (IsActive())
+#if !UE_SERVER
+	if (IsActive() && IndicatorViewModelInstance)
 	{
-		IndicatorViewModel->SetIndicatorVisibility(bInVisibility, InPriority);
+		IndicatorViewModelInstance->SetIndicatorVisibility(bInVisibility, InPriority);
 	}
+#endif
+}
+
+TSoftClassPtr<UUserWidget> UIndicatorComponent::GetIndicatorClass() const
+{
+	if (IndicatorViewModelInstance)
+	{
+		return IndicatorViewModelInstance->GetIndicatorClass();
+	}
+
+	return IndicatorConfig ? IndicatorConfig->IndicatorWidgetClass : TSoftClassPtr<UUserWidget>();
 }
 
 void UIndicatorComponent::SetIndicatorClass(TSoftClassPtr<UUserWidget> InIndicatorWidgetClass)
 {
-	IndicatorViewModel->SetIndicatorClass(MoveTemp(InIndicatorWidgetClass));
+	if (UBaseIndicatorViewModel* ViewModel = GetOrCreateIndicatorViewModel())
+	{
+		ViewModel->SetIndicatorClass(MoveTemp(InIndicatorWidgetClass));
+	}
 }
 
-void UIndicatorComponent::SetIndicatorWorldOffset(const FVector& InWorldOffset) const
+void UIndicatorComponent::SetIndicatorWorldOffset(const FVector& InWorldOffset)
 {
-	IndicatorViewModel->SetWorldPositionOffset(InWorldOffset);
+	if (UBaseIndicatorViewModel* ViewModel = GetOrCreateIndicatorViewModel())
+	{
+		ViewModel->SetWorldPositionOffset(InWorldOffset);
+	}
 }
@@ -0,0 +1,13 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#include "DataAssets/UiScreensData.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UiScreensData)
+
+#if WITH_EDITOR
+void UUiScreensData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	OnScreensDataChanged.Broadcast(this);
+}
+#endif
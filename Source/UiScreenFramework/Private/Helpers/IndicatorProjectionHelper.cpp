@@ -11,26 +11,45 @@
 
 namespace IndicatorProjectionHelper
 {
-	bool Project(const UBaseIndicatorViewModel& Indicator, const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea,
+	bool Project(const UBaseIndicatorViewModel& Indicator, const FIndicatorProjectionView& View, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea,
 		FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack, float& OutTrackArrowAngle, FVector& OutWorldPosition)
+	{
+		FIndicatorProjectionInput ProjectionInput;
+		if (!GatherProjectionInput(Indicator, ProjectionInput))
+		{
+			return false;
+		}
+
+		return ProjectInput(ProjectionInput, View, ScreenSize, ScreenEdgeMarkersTrackArea, OutScreenPosition, bOutIsOnTheTrack, OutTrackArrowAngle, OutWorldPosition);
+	}
+
+	bool GatherProjectionInput(const UBaseIndicatorViewModel& Indicator, FIndicatorProjectionInput& OutProjectionInput)
 	{
 		const EIndicatorProjectionMode ProjectionMode = Indicator.GetProjectionMode();
 
-		if (ProjectionMode != EIndicatorProjectionMode::FixedPoint)
+		OutProjectionInput.ProjectionMode = ProjectionMode;
+		OutProjectionInput.WorldPositionOffset = Indicator.GetWorldPositionOffset();
+		OutProjectionInput.BoundingBoxAnchor = Indicator.GetBoundingBoxAnchor();
+		OutProjectionInput.ScreenSpaceOffset = Indicator.GetScreenSpaceOffset();
+		OutProjectionInput.bClampToScreen = Indicator.GetClampToScreen();
+
+		if (ProjectionMode == EIndicatorProjectionMode::FixedPoint)
 		{
-			const AActor* ActorAttachedTo = Indicator.GetActorAttachedTo();
-			if (!IsValid(ActorAttachedTo))
-			{
-				UE_LOG(LogBaseIndicatorViewModel, Warning, TEXT("%hs: ActorAttachedTo isn't set"), __FUNCTION__);
-				return false;
-			}
+			OutProjectionInput.Center = Indicator.GetFixedWorldPosition();
+			return true;
+		}
+
+		const AActor* ActorAttachedTo = Indicator.GetActorAttachedTo();
+		if (!IsValid(ActorAttachedTo))
+		{
+			UE_LOG(LogBaseIndicatorViewModel, Warning, TEXT("%hs: ActorAttachedTo isn't set"), __FUNCTION__);
+			return false;
 		}
 
-		FBox BoundingBox;
-		FVector Center = FVector::Zero();
+		FBox& BoundingBox = OutProjectionInput.BoundingBox;
+		FVector& Center = OutProjectionInput.Center;
 
-		const ACharacter* CharacterTypeActor = Cast<ACharacter>(Indicator.GetActorAttachedTo());
-		if (IsValid(CharacterTypeActor))
+		if (const ACharacter* CharacterTypeActor = Cast<ACharacter>(ActorAttachedTo))
 		{
 			if (ProjectionMode == EIndicatorProjectionMode::ActorSkeletalMeshBoundingBox)
 			{
@@ -44,9 +63,8 @@ namespace IndicatorProjectionHelper
 				Center = BoundingBox.GetCenter();
 			}
 		}
-		else if (ProjectionMode != EIndicatorProjectionMode::FixedPoint)
+		else
 		{
-			const AActor* ActorAttachedTo = Indicator.GetActorAttachedTo();
 			BoundingBox = ActorAttachedTo->GetComponentsBoundingBox();
 
 			USceneComponent* RootComponent = ActorAttachedTo->GetRootComponent();
@@ -65,42 +83,47 @@ namespace IndicatorProjectionHelper
 			}
 		}
 
-		const bool bClampToScreen = Indicator.GetClampToScreen();
+		return true;
+	}
+
+	bool ProjectInput(const FIndicatorProjectionInput& ProjectionInput, const FIndicatorProjectionView& View, const FVector2f& ScreenSize,
+		const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea, FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack, float& OutTrackArrowAngle, FVector& OutWorldPosition)
+	{
+		const FBox& BoundingBox = ProjectionInput.BoundingBox;
+		const FVector& Center = ProjectionInput.Center;
+		const FVector& WorldPositionOffset = ProjectionInput.WorldPositionOffset;
 
 		bool bWasProjectionOk;
 
-		switch (ProjectionMode)
+		switch (ProjectionInput.ProjectionMode)
 		{
 		case EIndicatorProjectionMode::FixedPoint:
-			OutWorldPosition = Indicator.GetFixedWorldPosition() + Indicator.GetWorldPositionOffset();
-			bWasProjectionOk = ProjectActorRoot(InProjectionData, OutWorldPosition, ScreenSize, OutScreenPosition);
-			break;
 		case EIndicatorProjectionMode::ActorRoot:
-			OutWorldPosition = Center + Indicator.GetWorldPositionOffset();
-			bWasProjectionOk = ProjectActorRoot(InProjectionData, OutWorldPosition, ScreenSize, OutScreenPosition);
+			OutWorldPosition = Center + WorldPositionOffset;
+			bWasProjectionOk = ProjectActorRoot(View, OutWorldPosition, ScreenSize, OutScreenPosition);
 			break;
 		case EIndicatorProjectionMode::ActorBoundingBox:
 			OutWorldPosition = Center;
-			bWasProjectionOk = ProjectActorBoundingBox(InProjectionData, BoundingBox, Indicator.GetBoundingBoxAnchor(), OutWorldPosition, Indicator.GetWorldPositionOffset(), ScreenSize,
+			bWasProjectionOk = ProjectActorBoundingBox(View, BoundingBox, ProjectionInput.BoundingBoxAnchor, OutWorldPosition, WorldPositionOffset, ScreenSize,
 				OutScreenPosition);
 			break;
 		case EIndicatorProjectionMode::ActorSkeletalMeshBoundingBox:
 			OutWorldPosition = Center;
-			bWasProjectionOk = ProjectSkeletalMeshBoundingBox(InProjectionData, BoundingBox, Indicator.GetBoundingBoxAnchor(), OutWorldPosition, Indicator.GetWorldPositionOffset(), ScreenSize,
+			bWasProjectionOk = ProjectSkeletalMeshBoundingBox(View, BoundingBox, ProjectionInput.BoundingBoxAnchor, OutWorldPosition, WorldPositionOffset, ScreenSize,
 				OutScreenPosition);
 			break;
 		case EIndicatorProjectionMode::ActorScreenBoundingBox:
 			OutWorldPosition = BoundingBox.GetCenter();
-			bWasProjectionOk = ProjectActorScreenBoundingBox(InProjectionData, BoundingBox, Indicator.GetBoundingBoxAnchor(), ScreenSize, OutScreenPosition);
+			bWasProjectionOk = ProjectActorScreenBoundingBox(View, BoundingBox, ProjectionInput.BoundingBoxAnchor, ScreenSize, OutScreenPosition);
 			break;
 		default:
 			check(false);
 			return false;
 		}
 
-		OutScreenPosition += Indicator.GetScreenSpaceOffset();
+		OutScreenPosition += ProjectionInput.ScreenSpaceOffset;
 
-		if (!bClampToScreen)
+		if (!ProjectionInput.bClampToScreen)
 		{
 			bOutIsOnTheTrack = false;
 			return bWasProjectionOk;
@@ -118,9 +141,28 @@ namespace IndicatorProjectionHelper
 
 		// Clamp screen edge marker into area track.
 		bOutIsOnTheTrack = true;
+		ClampToScreenEdgeMarkerTrack(OutScreenPosition, ScreenSize, ScreenEdgeMarkersTrackArea, OutTrackArrowAngle);
+
+		return true;
+	}
 
+	bool ProjectWorldPoint(const FIndicatorProjectionView& View, const FVector& WorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenPosition)
+	{
+		const FVector4 ClipPosition = View.ViewProjectionMatrix.TransformFVector4(FVector4(WorldLocation, 1.0));
+		const bool bInFrontOfCamera = ClipPosition.W > 0.0;
+		const double InvW = ClipPosition.W != 0.0 ? 1.0 / FMath::Abs(ClipPosition.W) : 1.0;
+
+		OutScreenPosition.X = (0.5 + ClipPosition.X * 0.5 * InvW) * ScreenSize.X;
+		OutScreenPosition.Y = (0.5 - ClipPosition.Y * 0.5 * InvW) * ScreenSize.Y;
+
+		return bInFrontOfCamera;
+	}
+
+	void ClampToScreenEdgeMarkerTrack(FVector2D& InOutScreenPosition, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea,
+		float& OutTrackArrowAngle)
+	{
 		const FVector2D HalfScreenSize = FVector2D(ScreenSize) * 0.5;
-		FVector2D CartesianCoords = OutScreenPosition - HalfScreenSize;
+		FVector2D CartesianCoords = InOutScreenPosition - HalfScreenSize;
 		const FVector2D MarkerAreaHalfDimensions = HalfScreenSize - FVector2D(ScreenEdgeMarkersTrackArea.Offsets.Left, ScreenEdgeMarkersTrackArea.Offsets.Top);
 
 		double RatioX = UE_BIG_NUMBER;
@@ -154,9 +196,7 @@ namespace IndicatorProjectionHelper
 		CartesianCoords *= MinRatio;
 
 		// Return to screen space
-		OutScreenPosition = CartesianCoords + HalfScreenSize;
-
-		return true;
+		InOutScreenPosition = CartesianCoords + HalfScreenSize;
 	}
 
 	FBox GetBoundingBoxFromCapsule(UCapsuleComponent* Capsule)
@@ -194,16 +234,16 @@ namespace IndicatorProjectionHelper
 			(ScreenPosition.Y >= Offsets.Top) && (ScreenPosition.Y <= (ScreenSize.Y - Offsets.Bottom)));
 	}
 
-	bool ProjectActorRoot(const FSceneViewProjectionData& InProjectionData, const FVector& ProjectWorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition)
+	bool ProjectActorRoot(const FIndicatorProjectionView& View, const FVector& ProjectWorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition)
 	{
-		return ULocalPlayer::GetPixelPoint(InProjectionData, ProjectWorldLocation, OutScreenSpacePosition, &ScreenSize);
+		return ProjectWorldPoint(View, ProjectWorldLocation, ScreenSize, OutScreenSpacePosition);
 	}
 
-	bool ProjectActorScreenBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector2f& ScreenSize,
+	bool ProjectActorScreenBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector2f& ScreenSize,
 		FVector2D& OutScreenSpacePosition)
 	{
 		FVector2D LowerLeft, UpperRight;
-		if (ULocalPlayer::GetPixelBoundingBox(InProjectionData, BoundingBox, LowerLeft, UpperRight, &ScreenSize))
+		if (ULocalPlayer::GetPixelBoundingBox(View.ProjectionData, BoundingBox, LowerLeft, UpperRight, &ScreenSize))
 		{
 			OutScreenSpacePosition.X = FMath::Lerp(LowerLeft.X, UpperRight.X, BoundingBoxAnchor.X);
 			OutScreenSpacePosition.Y = FMath::Lerp(LowerLeft.Y, UpperRight.Y, BoundingBoxAnchor.Y);
@@ -213,17 +253,17 @@ namespace IndicatorProjectionHelper
 		return false;
 	}
 
-	bool ProjectActorBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center, const FVector& WorldPositionOffset,
+	bool ProjectActorBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center, const FVector& WorldPositionOffset,
 		const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition)
 	{
 		const FVector ProjectBoxPoint = Center + (BoundingBox.GetSize() * (BoundingBoxAnchor - FVector(0.5))) + WorldPositionOffset;
 
-		return ULocalPlayer::GetPixelPoint(InProjectionData, ProjectBoxPoint, OutScreenSpacePosition, &ScreenSize);
+		return ProjectWorldPoint(View, ProjectBoxPoint, ScreenSize, OutScreenSpacePosition);
 	}
 
-	bool ProjectSkeletalMeshBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
+	bool ProjectSkeletalMeshBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
 		const FVector& WorldPositionOffset, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition)
 	{
-		return ProjectActorBoundingBox(InProjectionData, BoundingBox, BoundingBoxAnchor, Center, WorldPositionOffset, ScreenSize, OutScreenSpacePosition);
+		return ProjectActorBoundingBox(View, BoundingBox, BoundingBoxAnchor, Center, WorldPositionOffset, ScreenSize, OutScreenSpacePosition);
 	}
 }
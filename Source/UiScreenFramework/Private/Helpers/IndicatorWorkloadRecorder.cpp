@@ -0,0 +1,379 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#include "Helpers/IndicatorWorkloadRecorder.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/LogUiScreenManager.h"
+#include "Logging/UiScreenFrameworkTrace.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "SceneView.h"
+#include "Serialization/ArchiveLoadCompressedProxy.h"
+#include "Serialization/ArchiveSaveCompressedProxy.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Widgets/SIndicatorCanvas.h"
+
+namespace IndicatorWorkloadRecorder
+{
+	constexpr uint32 FileMagic = 0x4C575549; // "UIWL"
+	constexpr uint32 FileVersion = 1;
+
+	/** Frames recorded when the record command doesn't specify a count, a minute at 60 fps. */
+	constexpr int32 DefaultMaxFrames = 3600;
+
+	/** Largest screen space difference, in pixels, still considered a match of the recorded result. */
+	constexpr double ReplayTolerance = 0.01;
+
+	/** Canvas update delta time of the replay, the recording doesn't keep the frame times. */
+	constexpr float ReplayDeltaTime = 1.f / 60.f;
+
+	struct FRecordedIndicator
+	{
+		FIndicatorProjectionInput ProjectionInput;
+		FVector2D ScreenPosition = FVector2D::ZeroVector;
+		bool bProjected = false;
+		bool bIsOnTheTrack = false;
+
+		friend FArchive& operator<<(FArchive& Ar, FRecordedIndicator& Indicator)
+		{
+			Ar << Indicator.ProjectionInput;
+			Ar << Indicator.ScreenPosition;
+			Ar << Indicator.bProjected;
+			Ar << Indicator.bIsOnTheTrack;
+			return Ar;
+		}
+	};
+
+	struct FRecordedFrame
+	{
+		FVector ViewOrigin = FVector::ZeroVector;
+		FMatrix ViewRotationMatrix = FMatrix::Identity;
+		FMatrix ProjectionMatrix = FMatrix::Identity;
+		FIntRect ViewRect;
+		FVector2f ScreenSize = FVector2f::ZeroVector;
+		FMargin TrackOffsets;
+		TArray<FRecordedIndicator> Indicators;
+
+		FSceneViewProjectionData MakeProjectionData() const
+		{
+			FSceneViewProjectionData ProjectionData;
+			ProjectionData.ViewOrigin = ViewOrigin;
+			ProjectionData.ViewRotationMatrix = ViewRotationMatrix;
+			ProjectionData.ProjectionMatrix = ProjectionMatrix;
+			ProjectionData.SetViewRectangle(ViewRect);
+			return ProjectionData;
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FRecordedFrame& Frame)
+		{
+			Ar << Frame.ViewOrigin;
+			Ar << Frame.ViewRotationMatrix;
+			Ar << Frame.ProjectionMatrix;
+			Ar << Frame.ViewRect;
+			Ar << Frame.ScreenSize;
+			Ar << Frame.TrackOffsets.Left << Frame.TrackOffsets.Top << Frame.TrackOffsets.Right << Frame.TrackOffsets.Bottom;
+			Ar << Frame.Indicators;
+			return Ar;
+		}
+	};
+
+	struct FRecording
+	{
+		TArray<FRecordedFrame> Frames;
+		int32 MaxFrames = DefaultMaxFrames;
+	};
+
+	TUniquePtr<FRecording> ActiveRecording;
+
+	FString GetRecordingDir()
+	{
+		return FPaths::ProfilingDir() / TEXT("UiIndicators");
+	}
+
+	bool SaveRecording(TArray<FRecordedFrame>& Frames, const FString& FilePath)
+	{
+		// The payload is compressed, frames of a match repeat a lot of the same configuration
+		TArray<uint8> Payload;
+		FArchiveSaveCompressedProxy Compressor(Payload, NAME_Zlib);
+		int32 NumFrames = Frames.Num();
+		Compressor << NumFrames;
+		for (FRecordedFrame& Frame : Frames)
+		{
+			Compressor << Frame;
+		}
+		Compressor.Flush();
+
+		TArray<uint8> FileData;
+		FMemoryWriter Writer(FileData);
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		Writer << Magic << Version << Payload;
+
+		return FFileHelper::SaveArrayToFile(FileData, *FilePath);
+	}
+
+	bool LoadRecording(const FString& FilePath, TArray<FRecordedFrame>& OutFrames)
+	{
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Failed to read %s"), __FUNCTION__, *FilePath);
+			return false;
+		}
+
+		FMemoryReader Reader(FileData);
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		TArray<uint8> Payload;
+		Reader << Magic << Version;
+		if (Magic != FileMagic || Version != FileVersion)
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs %s isn't an indicator workload recording of version %u"), __FUNCTION__, *FilePath, FileVersion);
+			return false;
+		}
+
+		Reader << Payload;
+		FArchiveLoadCompressedProxy Decompressor(Payload, NAME_Zlib);
+		int32 NumFrames = 0;
+		Decompressor << NumFrames;
+		if (Decompressor.IsError() || NumFrames < 0)
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs %s is corrupted"), __FUNCTION__, *FilePath);
+			return false;
+		}
+
+		OutFrames.SetNum(NumFrames);
+		for (FRecordedFrame& Frame : OutFrames)
+		{
+			Decompressor << Frame;
+		}
+
+		return !Decompressor.IsError();
+	}
+
+	bool IsRecording()
+	{
+		return ActiveRecording.IsValid();
+	}
+
+	void StopRecording()
+	{
+		if (!ActiveRecording)
+		{
+			return;
+		}
+
+		const TUniquePtr<FRecording> Recording = MoveTemp(ActiveRecording);
+		const FString FilePath = GetRecordingDir() / FString::Printf(TEXT("IndicatorWorkload-%s.uiwl"), *FDateTime::Now().ToString());
+
+		// Recordings stop from the canvas update once full, compressing and writing them there would hitch the frame
+		const char* FunctionName = __FUNCTION__;
+		Async(EAsyncExecution::ThreadPool, [Frames = MoveTemp(Recording->Frames), FilePath, FunctionName]() mutable
+		{
+			if (SaveRecording(Frames, FilePath))
+			{
+				UE_LOG(LogUiScreenFramework, Display, TEXT("%hs %d indicator frames written to %s"), FunctionName, Frames.Num(), *FilePath);
+			}
+			else
+			{
+				UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Failed to write the indicator recording to %s"), FunctionName, *FilePath);
+			}
+		});
+	}
+
+	void RecordFrame(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea)
+	{
+		if (!ActiveRecording)
+		{
+			return;
+		}
+
+		if (ActiveRecording->Frames.Num() >= ActiveRecording->MaxFrames)
+		{
+			StopRecording();
+			return;
+		}
+
+		FRecordedFrame& Frame = ActiveRecording->Frames.AddDefaulted_GetRef();
+		Frame.ViewOrigin = ProjectionData.ViewOrigin;
+		Frame.ViewRotationMatrix = ProjectionData.ViewRotationMatrix;
+		Frame.ProjectionMatrix = ProjectionData.ProjectionMatrix;
+		Frame.ViewRect = ProjectionData.GetViewRect();
+		Frame.ScreenSize = ScreenSize;
+		Frame.TrackOffsets = ScreenEdgeMarkersTrackArea.Offsets;
+
+		// Most frames see about as many indicators as the previous one
+		if (ActiveRecording->Frames.Num() > 1)
+		{
+			Frame.Indicators.Reserve(ActiveRecording->Frames.Last(1).Indicators.Num());
+		}
+	}
+
+	void RecordIndicator(const FIndicatorProjectionInput& ProjectionInput, const bool bProjected, const FVector2D& ScreenPosition, const bool bIsOnTheTrack)
+	{
+		if (!ActiveRecording || ActiveRecording->Frames.IsEmpty())
+		{
+			return;
+		}
+
+		FRecordedIndicator& Indicator = ActiveRecording->Frames.Last().Indicators.AddDefaulted_GetRef();
+		Indicator.ProjectionInput = ProjectionInput;
+		Indicator.ScreenPosition = ScreenPosition;
+		Indicator.bProjected = bProjected;
+		Indicator.bIsOnTheTrack = bIsOnTheTrack;
+	}
+
+	void Replay(const FString& FilePath, const int32 Iterations)
+	{
+		// The replay goes through the canvas update, which would record it again
+		if (IsRecording())
+		{
+			UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs Can't replay while an indicator recording is running"), __FUNCTION__);
+			return;
+		}
+
+		TArray<FRecordedFrame> Frames;
+		if (!LoadRecording(FilePath, Frames))
+		{
+			return;
+		}
+
+		int32 TotalIndicators = 0;
+		int32 MaxIndicators = 0;
+		TArray<TArray<FIndicatorProjectionInput>> FrameInputs;
+		FrameInputs.Reserve(Frames.Num());
+		for (const FRecordedFrame& Frame : Frames)
+		{
+			TotalIndicators += Frame.Indicators.Num();
+			MaxIndicators = FMath::Max(MaxIndicators, Frame.Indicators.Num());
+
+			TArray<FIndicatorProjectionInput>& Inputs = FrameInputs.AddDefaulted_GetRef();
+			Inputs.Reserve(Frame.Indicators.Num());
+			for (const FRecordedIndicator& Indicator : Frame.Indicators)
+			{
+				Inputs.Add(Indicator.ProjectionInput);
+			}
+		}
+
+		// A canvas without a player, the recorded frames drive its update instead of the viewport
+		const TSharedRef<SIndicatorCanvas> Canvas = SNew(SIndicatorCanvas, FLocalPlayerContext(), FScreenEdgeMarkersTrackArea());
+
+		TArray<double> FrameTimesUs;
+		FrameTimesUs.Reserve(Frames.Num() * Iterations);
+		int32 Mismatches = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+			{
+				UI_SCREEN_TRACE_SCOPE(TEXT("UiIndicator Replay Frame"));
+
+				const FRecordedFrame& Frame = Frames[FrameIndex];
+				const FSceneViewProjectionData ProjectionData = Frame.MakeProjectionData();
+				FScreenEdgeMarkersTrackArea TrackArea;
+				TrackArea.Offsets = Frame.TrackOffsets;
+
+				const double StartTime = FPlatformTime::Seconds();
+				Canvas->ReplayFrame(ProjectionData, Frame.ScreenSize, TrackArea, FrameInputs[FrameIndex], ReplayDeltaTime);
+				FrameTimesUs.Add((FPlatformTime::Seconds() - StartTime) * 1000000.0);
+
+				// Only the first pass is verified, the slots hold the results until the next frame
+				if (Iteration > 0)
+				{
+					continue;
+				}
+
+				for (int32 IndicatorIndex = 0; IndicatorIndex < Frame.Indicators.Num(); ++IndicatorIndex)
+				{
+					const FRecordedIndicator& Indicator = Frame.Indicators[IndicatorIndex];
+					FVector2D ScreenPosition = FVector2D::ZeroVector;
+					bool bIsOnTheTrack = false;
+					const bool bProjected = Canvas->GetReplayedIndicator(IndicatorIndex, ScreenPosition, bIsOnTheTrack);
+					if (bProjected != Indicator.bProjected
+						|| (bProjected && (bIsOnTheTrack != Indicator.bIsOnTheTrack || !ScreenPosition.Equals(Indicator.ScreenPosition, ReplayTolerance))))
+					{
+						++Mismatches;
+					}
+				}
+			}
+		}
+
+		if (FrameTimesUs.IsEmpty())
+		{
+			UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs %s has no frames"), __FUNCTION__, *FilePath);
+			return;
+		}
+
+		double SumUs = 0.0;
+		for (const double FrameTimeUs : FrameTimesUs)
+		{
+			SumUs += FrameTimeUs;
+		}
+
+		TArray<double> SortedFrameTimesUs = FrameTimesUs;
+		SortedFrameTimesUs.Sort();
+		const double P95Us = SortedFrameTimesUs[FMath::Clamp(FMath::CeilToInt32(0.95 * SortedFrameTimesUs.Num()) - 1, 0, SortedFrameTimesUs.Num() - 1)];
+		const double NsPerIndicator = TotalIndicators > 0 ? SumUs * 1000.0 / (static_cast<double>(TotalIndicators) * Iterations) : 0.0;
+
+		UE_LOG(LogUiScreenFramework, Display, TEXT("%hs %s: %d frames x %d, %.1f indicators per frame (max %d)"), __FUNCTION__, *FPaths::GetCleanFilename(FilePath),
+			Frames.Num(), Iterations, static_cast<double>(TotalIndicators) / Frames.Num(), MaxIndicators);
+		UE_LOG(LogUiScreenFramework, Display, TEXT("  Canvas update per frame: mean %.2f us, p95 %.2f us, max %.2f us, %.2f ns per indicator"), SumUs / FrameTimesUs.Num(),
+			P95Us, SortedFrameTimesUs.Last(), NsPerIndicator);
+
+		if (Mismatches > 0)
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs %d of %d replayed indicators don't match the recorded result"), __FUNCTION__, Mismatches, TotalIndicators);
+		}
+	}
+
+	FAutoConsoleCommandWithArgs RecordCommand(
+		TEXT("UiScreenFramework.Indicators.Record"),
+		TEXT("Records the view and the projection input of all visible indicators every canvas update, written under Saved/Profiling/UiIndicators once stopped. ")
+		TEXT("Arguments: Frames=3600 - stops automatically after that many frames, Stop - stops and writes the recording."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Stop"), ESearchCase::IgnoreCase); }))
+			{
+				StopRecording();
+				return;
+			}
+
+			if (ActiveRecording)
+			{
+				UE_LOG(LogUiScreenFramework, Warning, TEXT("Indicator recording is already running"));
+				return;
+			}
+
+			ActiveRecording = MakeUnique<FRecording>();
+			FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("Frames="), ActiveRecording->MaxFrames);
+			ActiveRecording->MaxFrames = FMath::Max(ActiveRecording->MaxFrames, 1);
+			UE_LOG(LogUiScreenFramework, Display, TEXT("Recording up to %d indicator frames"), ActiveRecording->MaxFrames);
+		}));
+
+	FAutoConsoleCommandWithArgs ReplayCommand(
+		TEXT("UiScreenFramework.Indicators.Replay"),
+		TEXT("Replays a recorded indicator workload through the update of an indicator canvas, verifies it reproduces the recorded results and reports the update cost. ")
+		TEXT("Doesn't need a world. Arguments: File=<name in Saved/Profiling/UiIndicators or absolute path> Iterations=1."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString Params = FString::Join(Args, TEXT(" "));
+			FString FileName;
+			int32 Iterations = 1;
+			if (!FParse::Value(*Params, TEXT("File="), FileName))
+			{
+				UE_LOG(LogUiScreenFramework, Error, TEXT("Indicator replay needs File=<recording>"));
+				return;
+			}
+			FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+			const FString FilePath = FPaths::IsRelative(FileName) ? GetRecordingDir() / FileName : FileName;
+			Replay(FilePath, FMath::Max(Iterations, 1));
+		}));
+}
+
+#endif
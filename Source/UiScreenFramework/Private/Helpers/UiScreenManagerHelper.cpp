@@ -14,9 +14,9 @@ FGameplayTag UiScreenManagerHelper::GetCurrentScreenTag(const UObject* WorldCont
 TObjectPtr<UScreenViewModel> UiScreenManagerHelper::GetCurrentScreenViewModel(const UObject* WorldContextObject)
 {
 	UUiScreenManager& UiScreenManager = UUiScreenManager::GetChecked(WorldContextObject);
-	const FGameplayTag CurrentScreenTag = GetCurrentScreenTag(WorldContextObject);
 
-	return UiScreenManager.GetScreenViewModel(CurrentScreenTag);
+	// Widgets constructed for a pending screen change resolve the view model of that screen
+	return UiScreenManager.GetScreenViewModel(UiScreenManager.GetDisplayingScreenTag());
 }
 
 const UUiScreenFrameworkSettings& UiScreenManagerHelper::GetUiScreenFrameworkSettings()
@@ -26,3 +26,24 @@ const UUiScreenFrameworkSettings& UiScreenManagerHelper::GetUiScreenFrameworkSet
 
 	return *UiScreenFrameworkSettings;
 }
+
+void UiScreenManagerHelper::GatherScreenAssetPaths(const FUiScreenInfo& ScreenInfo, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	if (!ScreenInfo.ScreenClass.IsNull())
+	{
+		OutAssetPaths.AddUnique(ScreenInfo.ScreenClass.ToSoftObjectPath());
+	}
+
+	if (!ScreenInfo.ScreenViewModelClass.IsNull())
+	{
+		OutAssetPaths.AddUnique(ScreenInfo.ScreenViewModelClass.ToSoftObjectPath());
+	}
+
+	for (const FSoftObjectPath& Dependency : ScreenInfo.Dependencies)
+	{
+		if (Dependency.IsValid())
+		{
+			OutAssetPaths.AddUnique(Dependency);
+		}
+	}
+}
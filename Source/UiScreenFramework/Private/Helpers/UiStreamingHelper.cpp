@@ -0,0 +1,98 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#include "Helpers/UiStreamingHelper.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/AssetManager.h"
+#include "Misc/PackageName.h"
+
+void UiStreamingHelper::CancelOrReleaseHandle(TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	if (Handle->IsLoadingInProgress())
+	{
+		Handle->CancelHandle();
+	}
+	else
+	{
+		Handle->ReleaseHandle();
+	}
+
+	Handle.Reset();
+}
+
+void UiStreamingHelper::RaiseLoadPriority(const FStreamableHandle& Handle, const TAsyncLoadPriority Priority)
+{
+	if (!Handle.IsLoadingInProgress())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> RequestedAssets;
+	Handle.GetRequestedAssets(RequestedAssets);
+
+	TSet<FName> PendingPackages;
+	for (const FSoftObjectPath& RequestedAsset : RequestedAssets)
+	{
+		if (!RequestedAsset.IsNull() && !RequestedAsset.ResolveObject())
+		{
+			PendingPackages.Add(RequestedAsset.GetLongPackageFName());
+		}
+	}
+
+	// The streamable manager doesn't request assets it already streams again, so its handles keep their original priority
+	for (const FName PackageName : PendingPackages)
+	{
+		LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate(), Priority);
+	}
+}
+
+int64 UiStreamingHelper::EstimateLoadSizeBytes(const TArray<FSoftObjectPath>& AssetPaths)
+{
+	if (!UAssetManager::IsInitialized())
+	{
+		return 0;
+	}
+
+	const IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
+
+	TArray<FName> PackagesToVisit;
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		PackagesToVisit.Add(AssetPath.GetLongPackageFName());
+	}
+
+	int64 SizeBytes = 0;
+	TSet<FName> VisitedPackages;
+	TArray<FName> Dependencies;
+	while (!PackagesToVisit.IsEmpty())
+	{
+		const FName PackageName = PackagesToVisit.Pop();
+
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(PackageName, &bAlreadyVisited);
+
+		// Loaded packages and their dependencies don't cost anything more
+		if (bAlreadyVisited || PackageName.IsNone() || FPackageName::IsScriptPackage(PackageName.ToString())
+			|| FindObjectFast<UPackage>(nullptr, PackageName))
+		{
+			continue;
+		}
+
+		if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+		{
+			SizeBytes += FMath::Max<int64>(PackageData->DiskSize, 0);
+		}
+
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		PackagesToVisit.Append(Dependencies);
+	}
+
+	return SizeBytes;
+}
@@ -4,6 +4,7 @@
 #include "Helpers/ViewModelHelper.h"
 
 #include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
 #include "Logging/LogUiScreenManager.h"
 #include "ViewModels/BaseViewModel.h"
 #include "View/MVVMView.h"
@@ -30,3 +31,38 @@ bool ViewModelHelper::SetViewModel(const UUserWidget* Widget, UBaseViewModel* Vi
 
 	return ViewExtension->SetViewModelByClass(ViewModel);
 }
+
+void ViewModelHelper::SuspendBindings(const UUserWidget& Widget, TArray<TWeakObjectPtr<UMVVMView>>& OutSuspendedViews)
+{
+	UMVVMView* ViewExtension = GetMvvmViewExtensionFromWidget(&Widget);
+	if (ViewExtension && ViewExtension->AreBindingsInitialized())
+	{
+		ViewExtension->UninitializeBindings();
+		OutSuspendedViews.Add(ViewExtension);
+	}
+
+	if (Widget.WidgetTree)
+	{
+		Widget.WidgetTree->ForEachWidget([&OutSuspendedViews](UWidget* ChildWidget)
+		{
+			if (const UUserWidget* ChildUserWidget = Cast<UUserWidget>(ChildWidget))
+			{
+				SuspendBindings(*ChildUserWidget, OutSuspendedViews);
+			}
+		});
+	}
+}
+
+void ViewModelHelper::ResumeBindings(TArray<TWeakObjectPtr<UMVVMView>>& SuspendedViews)
+{
+	for (const TWeakObjectPtr<UMVVMView>& SuspendedView : SuspendedViews)
+	{
+		UMVVMView* ViewExtension = SuspendedView.Get();
+		if (ViewExtension && !ViewExtension->AreBindingsInitialized())
+		{
+			ViewExtension->InitializeBindings();
+		}
+	}
+
+	SuspendedViews.Reset();
+}
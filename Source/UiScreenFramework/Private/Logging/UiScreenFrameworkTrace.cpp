@@ -0,0 +1,60 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#include "Logging/UiScreenFrameworkTrace.h"
+
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(UiScreenFrameworkChannel);
+CSV_DEFINE_CATEGORY_MODULE(UISCREENFRAMEWORK_API, UiScreenFramework, true);
+
+namespace UiScreenFrameworkTrace
+{
+	bool IsEnabled()
+	{
+#if CSV_PROFILER
+		if (FCsvProfiler::Get()->IsCapturing())
+		{
+			return true;
+		}
+#endif
+
+#if UE_TRACE_ENABLED
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(UiScreenFrameworkChannel);
+#else
+		return false;
+#endif
+	}
+
+	void BeginRegion(const FString& RegionName)
+	{
+#if UE_TRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(UiScreenFrameworkChannel))
+		{
+			TRACE_BEGIN_REGION(*RegionName);
+		}
+#endif
+		CSV_EVENT(UiScreenFramework, TEXT("Begin %s"), *RegionName);
+	}
+
+	void EndRegion(const FString& RegionName)
+	{
+#if UE_TRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(UiScreenFrameworkChannel))
+		{
+			TRACE_END_REGION(*RegionName);
+		}
+#endif
+		CSV_EVENT(UiScreenFramework, TEXT("End %s"), *RegionName);
+	}
+
+	void Event(const FString& EventText)
+	{
+#if UE_TRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(UiScreenFrameworkChannel))
+		{
+			TRACE_BOOKMARK(TEXT("%s"), *EventText);
+		}
+#endif
+		CSV_EVENT(UiScreenFramework, TEXT("%s"), *EventText);
+	}
+}
@@ -116,7 +116,7 @@ FString UIndicatorManagerSubsystem::GetIndicatorDebugInfo(const UBaseIndicatorVi
 						"IndicatorWidget: {0} \nVisibility: {1} \nActorAttachedTo: {2}"
 						"\nIndicatorWidgetClass: {3} \nProjectionMode: {4}, HAlignment: {5}, VAlignment: {6}"
 						"\nBoundingBoxAnchor: {7}, ScreenSpaceOffset: {8}, WorldPositionOffset: {9}"
-						"\nbClampToScreen: {10}, Priority: {11}"
+						"\nbClampToScreen: {10}, Priority: {11}, IndicatorConfig: {12}"
 						),
 					{
 						IndicatorViewModel->IndicatorWidget.IsValid() ? IndicatorViewModel->IndicatorWidget->GetName() : TEXT("None"),
@@ -130,7 +130,8 @@ FString UIndicatorManagerSubsystem::GetIndicatorDebugInfo(const UBaseIndicatorVi
 						IndicatorViewModel->GetScreenSpaceOffset().ToString(),
 						IndicatorViewModel->GetWorldPositionOffset().ToString(),
 						IndicatorViewModel->GetClampToScreen() ? TEXT("True") : TEXT("False"),
-						FString::FromInt(IndicatorViewModel->GetPriority())
+						FString::FromInt(IndicatorViewModel->GetPriority()),
+						GetNameSafe(&IndicatorViewModel->GetIndicatorConfig())
 					}
 					)
 				);
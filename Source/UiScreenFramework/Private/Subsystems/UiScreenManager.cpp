@@ -2,15 +2,69 @@
 
 #include "Subsystems/UiScreenManager.h"
 
+#include "Algo/AllOf.h"
+#include "Algo/Transform.h"
+#include "Async/Async.h"
 #include "CommonActivatableWidget.h"
 #include "DeveloperSettings/UiScreenFrameworkSettings.h"
 #include "Engine/AssetManager.h"
 #include "Helpers/UiScreenManagerHelper.h"
+#include "Helpers/UiStreamingHelper.h"
+#include "Helpers/ViewModelHelper.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Logging/LogUiScreenManager.h"
+#include "Logging/UiScreenFrameworkTrace.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
 #include "ViewModels/ScreenViewModel.h"
+#include "Widgets/LayerWidget.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UiScreenManager)
 
+DECLARE_STATS_GROUP(TEXT("UiScreenFramework"), STATGROUP_UiScreenFramework, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Navigation (ms)"), STAT_UiScreenLastNavigationMs, STATGROUP_UiScreenFramework);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Navigation Load (ms)"), STAT_UiScreenLastNavigationLoadMs, STATGROUP_UiScreenFramework);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Navigation View Model (ms)"), STAT_UiScreenLastNavigationViewModelMs, STATGROUP_UiScreenFramework);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Navigation Construction (ms)"), STAT_UiScreenLastNavigationConstructionMs, STATGROUP_UiScreenFramework);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Navigation Activation (ms)"), STAT_UiScreenLastNavigationActivationMs, STATGROUP_UiScreenFramework);
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs DumpNavigationStatsCommand(
+		TEXT("UiScreenFramework.NavigationStats"),
+		TEXT("Logs per-screen navigation statistics of all local players. Arguments: Csv - also writes them under Saved/Profiling, Reset - clears them."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			if (!GameInstance)
+			{
+				return;
+			}
+
+			const bool bReset = Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Reset"), ESearchCase::IgnoreCase); });
+			const bool bWriteCsv = Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Csv"), ESearchCase::IgnoreCase); });
+			for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
+			{
+				UUiScreenManager* UiScreenManager = LocalPlayer ? LocalPlayer->GetSubsystem<UUiScreenManager>() : nullptr;
+				if (!UiScreenManager)
+				{
+					continue;
+				}
+
+				if (bReset)
+				{
+					UiScreenManager->ResetNavigationStats();
+				}
+				else
+				{
+					UiScreenManager->DumpNavigationStats(bWriteCsv);
+				}
+			}
+		}));
+}
+
 UUiScreenManager* UUiScreenManager::Get(const AController* Controller)
 {
 	if (const APlayerController* PlayerController = Cast<APlayerController>(Controller))
@@ -56,6 +110,12 @@ void UUiScreenManager::Initialize(FSubsystemCollectionBase& Collection)
 	ULocalPlayer* LocalPlayer = GetLocalPlayer();
 	check(IsValid(LocalPlayer));
 
+	StartWarmUp();
+
+#if WITH_EDITOR
+	GetMutableDefault<UUiScreenFrameworkSettings>()->OnSettingChanged().AddUObject(this, &UUiScreenManager::OnFrameworkSettingsChanged);
+#endif
+
 	LocalPlayer->OnPlayerControllerChanged().AddUObject(this, &UUiScreenManager::InitializeUiScreenManager);
 
 	APlayerController* PlayerController = LocalPlayer->GetPlayerController(GetWorld());
@@ -69,310 +129,1361 @@ void UUiScreenManager::CleanupAllScreenViewModels()
 {
 	for (auto& [ScreenTag, ScreenViewModel] : ScreenViewModelsMap)
 	{
-		DeinitScreenViewModel(ScreenViewModel);
+		DeferScreenViewModelDeinit(ScreenTag, ScreenViewModel);
 	}
 
 	ScreenViewModelsMap.Empty();
+	ScreenViewModelSnapshots.Empty();
 }
 
-void UUiScreenManager::Deinitialize()
+void UUiScreenManager::DeferScreenViewModelDeinit(const FGameplayTag ScreenTag, UScreenViewModel* ScreenViewModel)
 {
-	ULocalPlayer* LocalPlayer = GetLocalPlayer();
-	check(IsValid(LocalPlayer));
+	if (!IsValid(ScreenViewModel))
+	{
+		return;
+	}
 
-	LocalPlayer->OnPlayerControllerChanged().RemoveAll(this);
+	FlushDeferredScreenViewModelDeinit(ScreenTag);
+	ViewModelsPendingDeinit.Add(ScreenTag, ScreenViewModel);
 
-	CleanupAllScreenViewModels();
+	if (!DeferredTeardownTickerHandle.IsValid())
+	{
+		DeferredTeardownTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUiScreenManager::ProcessDeferredTeardown));
+	}
+}
 
-	ScreensToDisplayQueue.Empty();
-	InitializeScreenWidgetCallback.Reset();
+void UUiScreenManager::FlushDeferredScreenViewModelDeinit(const FGameplayTag ScreenTag)
+{
+	TObjectPtr<UScreenViewModel> PendingViewModel;
+	if (ViewModelsPendingDeinit.RemoveAndCopyValue(ScreenTag, PendingViewModel))
+	{
+		DeinitScreenViewModel(PendingViewModel);
+	}
+}
 
-	if (UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget)
+bool UUiScreenManager::ProcessDeferredTeardown(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUiScreenManager_ProcessDeferredTeardown);
+
+	// Deinitializing during the transition would hitch it
+	const UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	if (IsValid(MainLayoutWidget) && MainLayoutWidget->IsAnyLayerTransitioning())
 	{
-		MainLayoutWidget->OnDisplayedWidgetChangedDelegate.Unbind();
+		return true;
 	}
 
-	if (StreamingHandle.IsValid())
+	const double BudgetSeconds = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetDeferredTeardownBudgetSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	while (!ViewModelsPendingDeinit.IsEmpty())
 	{
-		StreamingHandle.Reset();
+		// Deinit may change the queue, so the entry is removed before it runs
+		auto It = ViewModelsPendingDeinit.CreateIterator();
+		TObjectPtr<UScreenViewModel> PendingViewModel = It.Value();
+		It.RemoveCurrent();
+
+		DeinitScreenViewModel(PendingViewModel);
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
 	}
 
-	Super::Deinitialize();
+	if (ViewModelsPendingDeinit.IsEmpty())
+	{
+		DeferredTeardownTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
 }
 
-void UUiScreenManager::InitializeUiScreenManager(APlayerController* PlayerController)
+void UUiScreenManager::FlushDeferredTeardown()
 {
-	if (MainLayoutWidgetInfo.bAddedToViewport)
+	if (DeferredTeardownTickerHandle.IsValid())
 	{
-		RemoveMainLayoutWidget();
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredTeardownTickerHandle);
+		DeferredTeardownTickerHandle.Reset();
 	}
 
-	CreateMainLayoutWidget(PlayerController);
+	while (!ViewModelsPendingDeinit.IsEmpty())
+	{
+		auto It = ViewModelsPendingDeinit.CreateIterator();
+		TObjectPtr<UScreenViewModel> PendingViewModel = It.Value();
+		It.RemoveCurrent();
+
+		DeinitScreenViewModel(PendingViewModel);
+	}
 }
 
-void UUiScreenManager::OnScreenWidgetClassLoaded(FScreenInitialData ScreenInitialData)
+void UUiScreenManager::EnforceViewModelRetention()
 {
-	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Screen %s"), __FUNCTION__, *ScreenInitialData.ScreenTag.ToString());
-
-	FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenInitialData.ScreenTag);
-	if (!FoundViewInfo)
+	const int32 MaxRetainedScreenViewModels = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetMaxRetainedScreenViewModels();
+	const UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	if (MaxRetainedScreenViewModels <= 0 || ScreenViewModelsMap.Num() <= MaxRetainedScreenViewModels || !MainLayoutWidget)
 	{
 		return;
 	}
 
-	UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
-	if (!ensure(MainLayoutWidget))
+	// The newest screen of every layer below the current one is still displayed, its view model is bound
+	TSet<FGameplayTag> DisplayedScreens = {CurrentScreenState.ScreenId};
+	int32 LowestDisplayedLayerIndex = MainLayoutWidget->GetLayerIndex(CurrentScreenState.LayerId);
+	for (int32 Index = CurrentScreenState.PreviousScreens.Num() - 1; Index >= 0; --Index)
 	{
-		return;
+		const FGameplayTag& PreviousScreen = CurrentScreenState.PreviousScreens[Index];
+		const int32 LayerIndex = GetLayerIndexForScreen(PreviousScreen);
+		if (LayerIndex != INDEX_NONE && LayerIndex < LowestDisplayedLayerIndex)
+		{
+			DisplayedScreens.Add(PreviousScreen);
+			LowestDisplayedLayerIndex = LayerIndex;
+		}
 	}
 
-	CreateOrReuseScreenViewModel(ScreenInitialData, *FoundViewInfo);
-	SetCurrentScreenState(ScreenInitialData, *FoundViewInfo);
-	InitializeScreenWidgetCallback = ScreenInitialData.InitializeScreenWidgetCallback;
+	for (const FGameplayTag& PreviousScreen : CurrentScreenState.PreviousScreens)
+	{
+		if (ScreenViewModelsMap.Num() <= MaxRetainedScreenViewModels)
+		{
+			break;
+		}
+
+		if (DisplayedScreens.Contains(PreviousScreen))
+		{
+			continue;
+		}
 
-	MainLayoutWidget->SetWidgetForLayer(*FoundViewInfo, ScreenInitialData.bCleanUpExistingScreens);
+		// Stacked screens stay bound to their view model until they're displayed again or removed
+		const FUiScreenInfo* PreviousScreenInfo = GetUiScreenInfo(PreviousScreen);
+		if (PreviousScreenInfo && MainLayoutWidget->HasLiveWidgetOfClass(PreviousScreenInfo->ScreenClass.Get()))
+		{
+			continue;
+		}
+
+		TObjectPtr<UScreenViewModel> EvictedViewModel;
+		if (!ScreenViewModelsMap.RemoveAndCopyValue(PreviousScreen, EvictedViewModel) || !IsValid(EvictedViewModel))
+		{
+			continue;
+		}
 
-	const FGameplayTag PreviousScreenTag = CurrentScreenState.ScreenId;
-	const FGameplayTag NewScreenTag = FoundViewInfo->ScreenId;
-	BroadcastScreenChange(PreviousScreenTag, NewScreenTag);
+		TArray<uint8>& Snapshot = ScreenViewModelSnapshots.FindOrAdd(PreviousScreen);
+		Snapshot.Reset();
+		EvictedViewModel->SaveSnapshot(Snapshot);
 
-	// check whether other screens waiting to be displayed
-	FScreenInitialData EnqueuedScreenData;
-	ScreensToDisplayQueue.Dequeue(EnqueuedScreenData);
-	if (EnqueuedScreenData.ScreenTag.IsValid())
-	{
-		ChangeUiScreen(EnqueuedScreenData);
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs View model of %s evicted, snapshot size %d bytes"), __FUNCTION__, *PreviousScreen.ToString(), Snapshot.Num());
+
+		DeferScreenViewModelDeinit(PreviousScreen, EvictedViewModel);
 	}
 }
 
-void UUiScreenManager::CreateMainLayoutWidget(APlayerController* PlayerController)
+void UUiScreenManager::Deinitialize()
 {
 	ULocalPlayer* LocalPlayer = GetLocalPlayer();
 	check(IsValid(LocalPlayer));
 
-	ensure(LocalPlayer->GetPlayerController(GetWorld()) == PlayerController);
+	LocalPlayer->OnPlayerControllerChanged().RemoveAll(this);
 
-	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : RefreshLayout"), __FUNCTION__);
+#if WITH_EDITOR
+	GetMutableDefault<UUiScreenFrameworkSettings>()->OnSettingChanged().RemoveAll(this);
+	if (ScreensData)
+	{
+		ScreensData->OnScreensDataChanged.RemoveAll(this);
+	}
+#endif
 
-	if (ensure(PlayerController))
+	ScreenInfoIndices.Empty();
+	ScreensData = nullptr;
+
+	CleanupAllScreenViewModels();
+	FlushDeferredTeardown();
+
+	InitializeScreenWidgetCallbacks.Empty();
+	ActivationPendingTimings.Empty();
+	PendingScreenChange.Reset();
+	UiStreamingHelper::CancelOrReleaseHandle(DisplayedScreenHandle);
+
+	if (UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget)
 	{
-		const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
-		const TSubclassOf<UMainUiLayoutWidget> LayoutWidgetClassLoaded = ScreenFrameworkSettings.GetLayoutWidgetClass();
+		MainLayoutWidget->OnDisplayedWidgetChangedDelegate.Unbind();
+		MainLayoutWidget->OnWidgetAddedDelegate.Unbind();
+	}
 
-		if (ensure(LayoutWidgetClassLoaded && !LayoutWidgetClassLoaded->HasAnyClassFlags(CLASS_Abstract)))
-		{
-			UMainUiLayoutWidget* MainUiLayoutWidget = CreateWidget<UMainUiLayoutWidget>(PlayerController, LayoutWidgetClassLoaded);
-			MainLayoutWidgetInfo = {LocalPlayer, MainUiLayoutWidget, true};
-			MainUiLayoutWidget->OnDisplayedWidgetChangedDelegate.BindUObject(this, &UUiScreenManager::CallInitializeScreenWidgetCallback);
-			AddMainLayoutToViewport(MainUiLayoutWidget);
-		}
+	CancelPendingScreenRequests();
+
+	UiStreamingHelper::CancelOrReleaseHandle(LayoutWidgetClassHandle);
+	UiStreamingHelper::CancelOrReleaseHandle(ScreensDataHandle);
+	UiStreamingHelper::CancelOrReleaseHandle(StartupScreensHandle);
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PrefetchTimerHandle);
 	}
 
-	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : UIViewManager Layout initialized"), __FUNCTION__);
+	for (auto& [PrefetchedScreenTag, PrefetchedScreen] : PrefetchedScreens)
+	{
+		UiStreamingHelper::CancelOrReleaseHandle(PrefetchedScreen.Handle);
+	}
+
+	PrefetchedScreens.Empty();
+	PrefetchedBytes = 0;
+
+	PendingLayoutPlayerController.Reset();
+	bLayoutWidgetClassReady = false;
+	bScreensDataReady = false;
+
+	Super::Deinitialize();
 }
 
-void UUiScreenManager::RemoveMainLayoutWidget()
+void UUiScreenManager::InitializeUiScreenManager(APlayerController* PlayerController)
 {
-	if (!IsValid(MainLayoutWidgetInfo.MainLayoutWidget))
+	if (MainLayoutWidgetInfo.bAddedToViewport)
 	{
-		MainLayoutWidgetInfo.MainLayoutWidget = nullptr;
-		return;
+		RemoveMainLayoutWidget();
 	}
 
-	if (!MainLayoutWidgetInfo.bAddedToViewport)
+	if (!bLayoutWidgetClassReady)
 	{
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : Layout widget class is still streaming, layout will be created once it's loaded"), __FUNCTION__);
+		PendingLayoutPlayerController = PlayerController;
 		return;
 	}
 
-	RemoveMainLayoutFromViewport(*MainLayoutWidgetInfo.MainLayoutWidget);
-	MainLayoutWidgetInfo.bAddedToViewport = false;
+	CreateMainLayoutWidget(PlayerController);
+	TryProcessQueuedScreens();
 }
 
-void UUiScreenManager::DeinitScreenViewModel(UScreenViewModel* ScreenViewModel)
+void UUiScreenManager::StartWarmUp()
 {
-	if (IsValid(ScreenViewModel))
+	WarmUpStartTime = FPlatformTime::Seconds();
+
+	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+
+	const TSoftClassPtr<UMainUiLayoutWidget>& LayoutWidgetSoftClass = ScreenFrameworkSettings.GetLayoutWidgetSoftClass();
+	if (LayoutWidgetSoftClass.IsNull() || LayoutWidgetSoftClass.IsValid())
 	{
-		ScreenViewModel->Deinit();
-		ScreenViewModel = nullptr;
+		bLayoutWidgetClassReady = true;
 	}
-}
-
-void UUiScreenManager::SetCurrentScreenState(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo)
-{
-	const FGameplayTag& ScreenId = FoundViewInfo.ScreenId;
-	if (CurrentScreenState.ScreenId.IsValid())
+	else
 	{
-		CurrentScreenState.PreviousScreens.Add(CurrentScreenState.ScreenId);
+		LayoutWidgetClassHandle = StreamableManager.RequestAsyncLoad(LayoutWidgetSoftClass.ToSoftObjectPath(),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnLayoutWidgetClassLoaded), UiStreamingHelper::InteractiveScreenPriority);
 	}
 
-	if (ScreenInitialData.bCleanUpExistingScreens)
+	const TSoftObjectPtr<UUiScreensData>& ScreensDataSoftPtr = ScreenFrameworkSettings.GetScreensDataSoftPtr();
+	if (ScreensDataSoftPtr.IsNull() || ScreensDataSoftPtr.IsValid())
 	{
-		CurrentScreenState.PreviousScreens.Empty();
+		OnScreensDataLoaded();
 	}
-
-	int32 ExistingScreenIndex = -1;
-	if (CurrentScreenState.PreviousScreens.Find(ScreenId, ExistingScreenIndex))
+	else
 	{
-		const int32 NumElementsToRemove = CurrentScreenState.PreviousScreens.Num() - ExistingScreenIndex;
+		ScreensDataHandle = StreamableManager.RequestAsyncLoad(ScreensDataSoftPtr.ToSoftObjectPath(),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnScreensDataLoaded), UiStreamingHelper::InteractiveScreenPriority);
+	}
+}
 
-		for (int32 Index = ExistingScreenIndex + 1; Index < CurrentScreenState.PreviousScreens.Num(); ++Index)
-		{
-			FGameplayTag RemovedTag = CurrentScreenState.PreviousScreens[Index];
-			UScreenViewModel* ScreenViewModel = GetScreenViewModel(RemovedTag);
-			DeinitScreenViewModel(ScreenViewModel);
-			ScreenViewModelsMap.Remove(RemovedTag);
-		}
+void UUiScreenManager::OnLayoutWidgetClassLoaded()
+{
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : Layout widget class loaded after %.2f ms"), __FUNCTION__, (FPlatformTime::Seconds() - WarmUpStartTime) * 1000.0);
 
-		CurrentScreenState.PreviousScreens.RemoveAt(ExistingScreenIndex, NumElementsToRemove);
+	bLayoutWidgetClassReady = true;
+
+	if (APlayerController* PlayerController = PendingLayoutPlayerController.Get())
+	{
+		PendingLayoutPlayerController.Reset();
+		CreateMainLayoutWidget(PlayerController);
 	}
 
-	CurrentScreenState.ScreenId = ScreenId;
-	CurrentScreenState.LayerId = FoundViewInfo.LayerId;
+	TryProcessQueuedScreens();
 }
 
-void UUiScreenManager::CreateOrReuseScreenViewModel(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo)
+void UUiScreenManager::OnScreensDataLoaded()
 {
-	const TSoftClassPtr<UScreenViewModel> ScreeViewModelClass = FoundViewInfo.ScreenViewModelClass;
-	if (ScreeViewModelClass.IsNull())
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : Screens data loaded after %.2f ms"), __FUNCTION__, (FPlatformTime::Seconds() - WarmUpStartTime) * 1000.0);
+
+	BuildScreenInfoLookup();
+	bScreensDataReady = true;
+
+	LoadStartupScreens();
+	TryProcessQueuedScreens();
+}
+
+void UUiScreenManager::LoadStartupScreens()
+{
+	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+
+	TArray<FSoftObjectPath> StartupScreenPaths;
+	for (const FGameplayTag& StartupScreenTag : ScreenFrameworkSettings.GetStartupScreens())
 	{
-		UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs ScreeViewModelClass is empty for %s Screen View model won't be created"), __FUNCTION__, *FoundViewInfo.ScreenId.ToString());
-		return;
+		if (const FUiScreenInfo* ScreenInfo = GetUiScreenInfo(StartupScreenTag))
+		{
+			UiScreenManagerHelper::GatherScreenAssetPaths(*ScreenInfo, StartupScreenPaths);
+		}
 	}
 
-	if (ScreenInitialData.bCleanUpExistingScreens)
+	if (StartupScreenPaths.IsEmpty())
 	{
-		CleanupAllScreenViewModels();
+		return;
 	}
-	
-	UScreenViewModel* ScreenViewModel = GetScreenViewModel(FoundViewInfo.ScreenId);
 
-	if (!IsValid(ScreenViewModel))
-	{
-		const UClass* ScreenViewModelClass = ScreeViewModelClass.LoadSynchronous();
-		ScreenViewModel = NewObject<UScreenViewModel>(this, ScreenViewModelClass);
-		ScreenViewModel->Init();
+	StartupScreensHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(StartupScreenPaths), FStreamableDelegate(),
+		UiStreamingHelper::InteractiveScreenPriority);
+}
 
-		ScreenViewModelsMap.Add(FoundViewInfo.ScreenId, ScreenViewModel);
+bool UUiScreenManager::IsReadyForScreenChanges() const
+{
+	return bScreensDataReady && bLayoutWidgetClassReady && IsValid(MainLayoutWidgetInfo.MainLayoutWidget);
+}
+
+void UUiScreenManager::TryProcessQueuedScreens()
+{
+	if (!IsReadyForScreenChanges())
+	{
+		return;
 	}
 
-	if (ScreenInitialData.InitializeViewModelCallback)
+	if (!bWarmUpFinished)
 	{
-		ScreenInitialData.InitializeViewModelCallback(ScreenViewModel);
+		bWarmUpFinished = true;
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : Warm-up finished after %.2f ms"), __FUNCTION__, (FPlatformTime::Seconds() - WarmUpStartTime) * 1000.0);
 	}
-}
 
-void UUiScreenManager::BroadcastScreenChange(const FGameplayTag PreviousScreenTag, const FGameplayTag CurrentScreenTag) const
-{
-	OnUiScreenChanged.Broadcast(PreviousScreenTag, CurrentScreenTag);
-	OnUiScreenChanged_BP.Broadcast(PreviousScreenTag, CurrentScreenTag);
+	ProcessPendingScreenRequests();
 }
 
-void UUiScreenManager::ChangeUiScreen(FScreenInitialData ScreenInitialData)
+void UUiScreenManager::ReportFirstInteractiveFrame()
 {
-	const FGameplayTag ScreenTag = ScreenInitialData.ScreenTag;
-
-	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenTag);
-	if (!FoundViewInfo)
+	if (bFirstInteractiveFrameReported)
 	{
 		return;
 	}
 
-	if (ScreenTag == CurrentScreenState.ScreenId && !ScreenInitialData.bCleanUpExistingScreens)
+	bFirstInteractiveFrameReported = true;
+
+	// The screen is displayed on the next frame, measure once it's rendered
+	if (const UWorld* World = GetWorld())
 	{
-		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs New screen id %s is the same as current one, change aborted"), __FUNCTION__, *ScreenTag.ToString());
-		return;
+		// Captured outside, inside the lambda it would name the lambda's call operator
+		const char* FunctionName = __FUNCTION__;
+		World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this, FunctionName]()
+		{
+			UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : Time to first interactive frame %.2f ms"), FunctionName, (FPlatformTime::Seconds() - WarmUpStartTime) * 1000.0);
+		}));
 	}
+}
 
-	TSoftClassPtr<UCommonActivatableWidget> ScreenWidgetSoftClass = FoundViewInfo->ScreenClass;
-	if (ScreenWidgetSoftClass.IsNull())
+void UUiScreenManager::SchedulePrefetchForCurrentScreen()
+{
+	const UWorld* World = GetWorld();
+	if (!World)
 	{
-		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Screen class isn't set up for screen %s"), __FUNCTION__, *ScreenTag.ToString());
 		return;
 	}
 
-	if (StreamingHandle && StreamingHandle->IsLoadingInProgress())
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(PrefetchTimerHandle);
+
+	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+	if (ScreenFrameworkSettings.GetMaxPrefetchedScreens() <= 0)
 	{
-		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Enqueue %s screen"), __FUNCTION__, *ScreenTag.ToString());
-		ScreensToDisplayQueue.Enqueue(ScreenInitialData);
 		return;
 	}
 
-	if (ScreenWidgetSoftClass.IsValid())
+	const float PrefetchIdleDelay = ScreenFrameworkSettings.GetPrefetchIdleDelay();
+	if (PrefetchIdleDelay > 0.f)
 	{
-		OnScreenWidgetClassLoaded(ScreenInitialData);
+		TimerManager.SetTimer(PrefetchTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::PrefetchLikelyNextScreens), PrefetchIdleDelay, false);
 	}
 	else
 	{
-		StreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
-			ScreenWidgetSoftClass.ToSoftObjectPath(),
-			FStreamableDelegate::CreateUObject(this, &ThisClass::OnScreenWidgetClassLoaded, ScreenInitialData)
-			);
+		PrefetchTimerHandle = TimerManager.SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::PrefetchLikelyNextScreens));
 	}
 }
 
-void UUiScreenManager::GoToThePreviousUiScreen()
+void UUiScreenManager::PrefetchLikelyNextScreens()
 {
-	if (CurrentScreenState.PreviousScreens.IsEmpty())
+	// Navigation in progress, the screen isn't idle
+	if (IsScreenRequestInFlight())
 	{
-		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Cannot go back to the previous screen, no previous screen cached"), __FUNCTION__);
 		return;
 	}
 
-	ChangeUiScreen(FScreenInitialData(CurrentScreenState.PreviousScreens.Last()));
-}
+	const FUiScreenInfo* CurrentScreenInfo = GetUiScreenInfo(CurrentScreenState.ScreenId);
+	if (!CurrentScreenInfo)
+	{
+		return;
+	}
 
-void UUiScreenManager::AddMainLayoutToViewport(UMainUiLayoutWidget* LayoutWidget)
-{
-	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs %s is adding the root layout %s to the viewport"), __FUNCTION__, *GetName(), *GetNameSafe(LayoutWidget));
+	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+	const int32 MaxPrefetchedScreens = ScreenFrameworkSettings.GetMaxPrefetchedScreens();
+	const int64 PrefetchMemoryBudgetBytes = ScreenFrameworkSettings.GetPrefetchMemoryBudgetBytes();
 
-	ULocalPlayer* LocalPlayer = GetLocalPlayer();
-	check(IsValid(LocalPlayer));
+	for (const FGameplayTag& NextScreenTag : CurrentScreenInfo->LikelyNextScreens)
+	{
+		if (PrefetchedScreens.Num() >= MaxPrefetchedScreens || PrefetchedBytes >= PrefetchMemoryBudgetBytes)
+		{
+			break;
+		}
 
-	const FLocalPlayerContext LocalPlayerContext = FLocalPlayerContext(LocalPlayer);
-	LayoutWidget->SetPlayerContext(LocalPlayerContext);
-	LayoutWidget->AddToPlayerScreen(MainLayoutWidgetZOrder);
-}
+		if (NextScreenTag == CurrentScreenState.ScreenId || PrefetchedScreens.Contains(NextScreenTag))
+		{
+			continue;
+		}
 
-void UUiScreenManager::RemoveMainLayoutFromViewport(UMainUiLayoutWidget& LayoutWidget)
-{
-	const TWeakPtr<SWidget> LayoutSlateWidget = LayoutWidget.GetCachedWidget();
-	if (LayoutSlateWidget.IsValid())
-	{
-		UE_LOG(LogUiScreenFramework, Log, TEXT("%s is removing root layout %s from the viewport"), *GetName(), *LayoutWidget.GetName());
+		const FUiScreenInfo* NextScreenInfo = GetUiScreenInfo(NextScreenTag);
+		if (!NextScreenInfo)
+		{
+			continue;
+		}
 
-		LayoutWidget.RemoveFromParent();
-		if (LayoutSlateWidget.IsValid())
+		TArray<FSoftObjectPath> NextScreenPaths;
+		UiScreenManagerHelper::GatherScreenAssetPaths(*NextScreenInfo, NextScreenPaths);
+		if (NextScreenPaths.IsEmpty())
 		{
-			UE_LOG(LogUiScreenFramework, Log, TEXT("Root layout [%s] has been removed from the viewport, but other references to its"
-				" underlying Slate widget still exist. Noting in case we leak it."), *LayoutWidget.GetName());
+			continue;
+		}
+
+		// Screens that wouldn't fit are never started, a smaller one further down the list still might
+		const int64 EstimatedSizeBytes = UiStreamingHelper::EstimateLoadSizeBytes(NextScreenPaths);
+		if (PrefetchedBytes + EstimatedSizeBytes > PrefetchMemoryBudgetBytes)
+		{
+			UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Screen %s (estimated %lld KB) doesn't fit in the memory budget, skipping it"), __FUNCTION__,
+				*NextScreenTag.ToString(), EstimatedSizeBytes / 1024);
+			continue;
+		}
+
+		UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Prefetching screen %s"), __FUNCTION__, *NextScreenTag.ToString());
+
+		// Reserved up front so following screens account for it, replaced with the measured size on completion
+		FPrefetchedScreen& PrefetchedScreen = PrefetchedScreens.Add(NextScreenTag);
+		PrefetchedScreen.SizeBytes = EstimatedSizeBytes;
+		PrefetchedBytes += EstimatedSizeBytes;
+
+		// Started stalled so the handle is stored before the completion callback can run synchronously
+		const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(NextScreenPaths),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnScreenPrefetched, NextScreenTag), UiStreamingHelper::PrefetchPriority, false, true);
+		PrefetchedScreen.Handle = Handle;
+
+		if (Handle.IsValid())
+		{
+			Handle->StartStalledHandle();
 		}
 	}
 }
 
-FUiScreenInfo* UUiScreenManager::GetUiScreenInfo(const FGameplayTag ScreenTag)
+void UUiScreenManager::OnScreenPrefetched(const FGameplayTag PrefetchedScreenTag)
 {
-	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
-	UUiScreensData* UiScreensData = ScreenFrameworkSettings.GetViewsData();
-	FUiScreenInfo* FoundViewInfo = UiScreensData->Screens.FindByPredicate([ScreenTag](const FUiScreenInfo& ViewInfo)
+	FPrefetchedScreen* PrefetchedScreen = PrefetchedScreens.Find(PrefetchedScreenTag);
+	if (!PrefetchedScreen || !PrefetchedScreen->Handle.IsValid())
 	{
-		return ViewInfo.ScreenId == ScreenTag;
-	});
+		return;
+	}
 
-	if (!FoundViewInfo)
+	PrefetchedBytes -= PrefetchedScreen->SizeBytes;
+	PrefetchedScreen->SizeBytes = 0;
+
+	TArray<UObject*> LoadedAssets;
+	PrefetchedScreen->Handle->GetLoadedAssets(LoadedAssets);
+	for (const UObject* LoadedAsset : LoadedAssets)
 	{
-		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs ViewInfo with ScreenTag %s hasn't been found in View Data asset"), __FUNCTION__, *ScreenTag.ToString());
-		return nullptr;
+		if (LoadedAsset)
+		{
+			PrefetchedScreen->SizeBytes += LoadedAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	const int64 PrefetchMemoryBudgetBytes = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetPrefetchMemoryBudgetBytes();
+	if (PrefetchedBytes + PrefetchedScreen->SizeBytes > PrefetchMemoryBudgetBytes)
+	{
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Prefetched screen %s (%lld KB) doesn't fit in the memory budget, releasing it"), __FUNCTION__,
+			*PrefetchedScreenTag.ToString(), PrefetchedScreen->SizeBytes / 1024);
+
+		UiStreamingHelper::CancelOrReleaseHandle(PrefetchedScreen->Handle);
+		PrefetchedScreens.Remove(PrefetchedScreenTag);
+		return;
 	}
 
-	return FoundViewInfo;
+	PrefetchedBytes += PrefetchedScreen->SizeBytes;
 }
 
-UScreenViewModel* UUiScreenManager::GetScreenViewModel(const FGameplayTag ScreenTag)
+void UUiScreenManager::ReleaseStalePrefetches(const FUiScreenInfo& NewScreenInfo)
 {
-	TObjectPtr<UScreenViewModel>* ScreenViewModelPtr = ScreenViewModelsMap.Find(ScreenTag);
-	if (!ScreenViewModelPtr)
+	for (auto It = PrefetchedScreens.CreateIterator(); It; ++It)
 	{
-		return nullptr;
+		if (NewScreenInfo.LikelyNextScreens.Contains(It.Key()))
+		{
+			continue;
+		}
+
+		// The displayed screen's assets are held by DisplayedScreenHandle by now, the prefetch handle isn't needed anymore
+		FPrefetchedScreen& PrefetchedScreen = It.Value();
+		UiStreamingHelper::CancelOrReleaseHandle(PrefetchedScreen.Handle);
+
+		PrefetchedBytes -= PrefetchedScreen.SizeBytes;
+		It.RemoveCurrent();
+	}
+}
+
+void UUiScreenManager::OnScreenRequestAssetsLoaded(const uint32 RequestId)
+{
+	FUiScreenRequest* ScreenRequest = FindPendingScreenRequest(RequestId);
+	if (!ScreenRequest)
+	{
+		UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Request %u isn't pending anymore"), __FUNCTION__, RequestId);
+		return;
+	}
+
+	UI_SCREEN_TRACE_END_REGION(TEXT("UiScreen Load %s #%u"), *ScreenRequest->InitialData.ScreenTag.ToString(), RequestId);
+
+	ScreenRequest->bAssetsLoaded = true;
+	ScreenRequest->Timing.LoadCompleteTime = FPlatformTime::Seconds();
+	DisplayLoadedScreenRequests();
+}
+
+void UUiScreenManager::DisplayScreenRequest(FUiScreenRequest&& ScreenRequest)
+{
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiScreen DisplayScreenRequest"));
+
+	FScreenInitialData& ScreenInitialData = ScreenRequest.InitialData;
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Screen %s, request %u"), __FUNCTION__, *ScreenInitialData.ScreenTag.ToString(), ScreenRequest.RequestId);
+
+	FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenInitialData.ScreenTag);
+	if (!FoundViewInfo)
+	{
+		return;
+	}
+
+	UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	if (!ensure(MainLayoutWidget))
+	{
+		return;
+	}
+
+	FUiScreenChange ScreenChange;
+	ScreenChange.ScreenTag = FoundViewInfo->ScreenId;
+	ScreenChange.PreviousScreenTag = CurrentScreenState.ScreenId;
+	ScreenChange.SkippedScreens = ScreenRequest.SkippedScreens;
+	ScreenChange.bCleanUpExistingScreens = ScreenInitialData.bCleanUpExistingScreens;
+	ScreenChange.StreamingHandle = MoveTemp(ScreenRequest.StreamingHandle);
+
+	// Superseded before its widget was complete, it goes to the history like a coalesced request
+	if (PendingScreenChange)
+	{
+		ScreenChange.SkippedScreens.Insert(PendingScreenChange->ScreenTag, 0);
+		ScreenChange.SkippedScreens.Insert(PendingScreenChange->SkippedScreens, 0);
+		ScreenChange.bCleanUpExistingScreens |= PendingScreenChange->bCleanUpExistingScreens;
+		UiStreamingHelper::CancelOrReleaseHandle(PendingScreenChange->StreamingHandle);
+	}
+
+	// View model resolvers of the widget constructed below already see the new screen
+	PendingScreenChange = MoveTemp(ScreenChange);
+
+	// Screens on higher layers (or all of them on cleanup) are removed, so are their callbacks
+	const int32 LayerIndex = MainLayoutWidget->GetLayerIndex(FoundViewInfo->LayerId);
+	for (auto It = InitializeScreenWidgetCallbacks.CreateIterator(); It; ++It)
+	{
+		if (ScreenInitialData.bCleanUpExistingScreens || MainLayoutWidget->GetLayerIndex(It.Key()) > LayerIndex)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	InitializeScreenWidgetCallbacks.Add(FoundViewInfo->LayerId, MoveTemp(ScreenInitialData.InitializeScreenWidgetCallback));
+
+	// Screens on higher layers won't be activated anymore, activation of this one is reported by its layer
+	for (auto It = ActivationPendingTimings.CreateIterator(); It; ++It)
+	{
+		if (ScreenInitialData.bCleanUpExistingScreens || MainLayoutWidget->GetLayerIndex(It.Key()) > LayerIndex)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FUiScreenNavigationTiming& Timing = ActivationPendingTimings.Add(FoundViewInfo->LayerId, MoveTemp(ScreenRequest.Timing));
+	if (Timing.TransitionStartTime <= 0.0)
+	{
+		Timing.TransitionStartTime = FPlatformTime::Seconds();
+	}
+
+	MainLayoutWidget->SetWidgetForLayer(*FoundViewInfo, ScreenInitialData.bCleanUpExistingScreens);
+	ReportFirstInteractiveFrame();
+
+	// Incrementally constructed screens become current once their widget is complete, see CallInitializeScreenWidgetCallback
+	const ULayerWidget* LayerWidget = MainLayoutWidget->GetLayerForScreenInfo(*FoundViewInfo);
+	if (!LayerWidget || !LayerWidget->IsConstructingWidget())
+	{
+		CommitPendingScreenChange();
+	}
+}
+
+void UUiScreenManager::CommitPendingScreenChange()
+{
+	if (!PendingScreenChange)
+	{
+		return;
+	}
+
+	FUiScreenChange ScreenChange = MoveTemp(*PendingScreenChange);
+	PendingScreenChange.Reset();
+
+	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenChange.ScreenTag);
+	if (!FoundViewInfo)
+	{
+		UiStreamingHelper::CancelOrReleaseHandle(ScreenChange.StreamingHandle);
+		return;
+	}
+
+	// Taken over before the stale prefetches are released, the new screen's prefetch might be among them
+	UiStreamingHelper::CancelOrReleaseHandle(DisplayedScreenHandle);
+	DisplayedScreenHandle = MoveTemp(ScreenChange.StreamingHandle);
+
+	SetCurrentScreenState(ScreenChange, *FoundViewInfo);
+	EnforceViewModelRetention();
+
+	ReleaseStalePrefetches(*FoundViewInfo);
+	SchedulePrefetchForCurrentScreen();
+
+	BroadcastScreenChange(ScreenChange.PreviousScreenTag, ScreenChange.ScreenTag);
+}
+
+void UUiScreenManager::CreateMainLayoutWidget(APlayerController* PlayerController)
+{
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	check(IsValid(LocalPlayer));
+
+	ensure(LocalPlayer->GetPlayerController(GetWorld()) == PlayerController);
+
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : RefreshLayout"), __FUNCTION__);
+
+	if (ensure(PlayerController))
+	{
+		// Class is streamed during the warm-up, it's already in memory here
+		const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+		const TSubclassOf<UMainUiLayoutWidget> LayoutWidgetClassLoaded = ScreenFrameworkSettings.GetLayoutWidgetSoftClass().Get();
+
+		if (ensure(LayoutWidgetClassLoaded && !LayoutWidgetClassLoaded->HasAnyClassFlags(CLASS_Abstract)))
+		{
+			UMainUiLayoutWidget* MainUiLayoutWidget = CreateWidget<UMainUiLayoutWidget>(PlayerController, LayoutWidgetClassLoaded);
+			MainLayoutWidgetInfo = {LocalPlayer, MainUiLayoutWidget, true};
+			MainUiLayoutWidget->OnDisplayedWidgetChangedDelegate.BindUObject(this, &UUiScreenManager::CallInitializeScreenWidgetCallback);
+			MainUiLayoutWidget->OnWidgetAddedDelegate.BindUObject(this, &UUiScreenManager::OnLayerWidgetAdded);
+			AddMainLayoutToViewport(MainUiLayoutWidget);
+		}
+	}
+
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs : UIViewManager Layout initialized"), __FUNCTION__);
+}
+
+void UUiScreenManager::RemoveMainLayoutWidget()
+{
+	if (!IsValid(MainLayoutWidgetInfo.MainLayoutWidget))
+	{
+		MainLayoutWidgetInfo.MainLayoutWidget = nullptr;
+		return;
+	}
+
+	if (!MainLayoutWidgetInfo.bAddedToViewport)
+	{
+		return;
+	}
+
+	RemoveMainLayoutFromViewport(*MainLayoutWidgetInfo.MainLayoutWidget);
+	MainLayoutWidgetInfo.bAddedToViewport = false;
+}
+
+void UUiScreenManager::DeinitScreenViewModel(UScreenViewModel* ScreenViewModel)
+{
+	if (IsValid(ScreenViewModel))
+	{
+		UI_SCREEN_TRACE_SCOPE_TEXT(*FString::Printf(TEXT("UiScreen ViewModel Deinit %s"), *ScreenViewModel->GetClass()->GetName()));
+		ScreenViewModel->Deinit();
+		ScreenViewModel = nullptr;
+	}
+}
+
+void UUiScreenManager::SetCurrentScreenState(const FUiScreenChange& ScreenChange, const FUiScreenInfo& FoundViewInfo)
+{
+	bool bCleanUpExistingScreens = ScreenChange.bCleanUpExistingScreens;
+	for (const FGameplayTag& SkippedScreen : ScreenChange.SkippedScreens)
+	{
+		AdvanceScreenHistory(SkippedScreen, bCleanUpExistingScreens);
+		bCleanUpExistingScreens = false;
+	}
+
+	AdvanceScreenHistory(FoundViewInfo.ScreenId, bCleanUpExistingScreens);
+	CurrentScreenState.LayerId = FoundViewInfo.LayerId;
+}
+
+void UUiScreenManager::AdvanceScreenHistory(const FGameplayTag ScreenId, const bool bCleanUpExistingScreens)
+{
+	if (CurrentScreenState.ScreenId.IsValid())
+	{
+		CurrentScreenState.PreviousScreens.Add(CurrentScreenState.ScreenId);
+	}
+
+	if (bCleanUpExistingScreens)
+	{
+		CurrentScreenState.PreviousScreens.Empty();
+	}
+
+	int32 ExistingScreenIndex = -1;
+	if (CurrentScreenState.PreviousScreens.Find(ScreenId, ExistingScreenIndex))
+	{
+		const int32 NumElementsToRemove = CurrentScreenState.PreviousScreens.Num() - ExistingScreenIndex;
+
+		for (int32 Index = ExistingScreenIndex + 1; Index < CurrentScreenState.PreviousScreens.Num(); ++Index)
+		{
+			FGameplayTag RemovedTag = CurrentScreenState.PreviousScreens[Index];
+			DeferScreenViewModelDeinit(RemovedTag, GetScreenViewModel(RemovedTag));
+			ScreenViewModelsMap.Remove(RemovedTag);
+			ScreenViewModelSnapshots.Remove(RemovedTag);
+		}
+
+		CurrentScreenState.PreviousScreens.RemoveAt(ExistingScreenIndex, NumElementsToRemove);
+	}
+
+	CurrentScreenState.ScreenId = ScreenId;
+}
+
+UScreenViewModel* UUiScreenManager::CreateOrReuseScreenViewModel(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo)
+{
+	const TSoftClassPtr<UScreenViewModel> ScreeViewModelClass = FoundViewInfo.ScreenViewModelClass;
+	if (ScreeViewModelClass.IsNull())
+	{
+		UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs ScreeViewModelClass is empty for %s Screen View model won't be created"), __FUNCTION__, *FoundViewInfo.ScreenId.ToString());
+		return nullptr;
+	}
+
+	if (ScreenInitialData.bCleanUpExistingScreens)
+	{
+		CleanupAllScreenViewModels();
+	}
+	
+	UScreenViewModel* ScreenViewModel = GetScreenViewModel(FoundViewInfo.ScreenId);
+	UScreenViewModel* CreatedViewModel = nullptr;
+
+	if (!IsValid(ScreenViewModel))
+	{
+		// Streamed together with the screen widget class in ChangeUiScreen
+		const UClass* ScreenViewModelClass = ScreeViewModelClass.Get();
+		if (!ScreenViewModelClass)
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs ScreeViewModelClass %s for %s isn't loaded, Screen View model won't be created"), __FUNCTION__,
+				*ScreeViewModelClass.ToString(), *FoundViewInfo.ScreenId.ToString());
+			return nullptr;
+		}
+
+		// The previous instance of this screen may still wait for its deferred teardown
+		FlushDeferredScreenViewModelDeinit(FoundViewInfo.ScreenId);
+
+		UI_SCREEN_TRACE_SCOPE_TEXT(*FString::Printf(TEXT("UiScreen ViewModel Init %s"), *ScreenViewModelClass->GetName()));
+		ScreenViewModel = NewObject<UScreenViewModel>(this, ScreenViewModelClass);
+		ScreenViewModel->Init();
+
+		TArray<uint8> Snapshot;
+		if (ScreenViewModelSnapshots.RemoveAndCopyValue(FoundViewInfo.ScreenId, Snapshot))
+		{
+			UE_LOG(LogUiScreenFramework, Log, TEXT("%hs View model of %s rehydrated from snapshot"), __FUNCTION__, *FoundViewInfo.ScreenId.ToString());
+			ScreenViewModel->RestoreSnapshot(Snapshot);
+		}
+
+		ScreenViewModelsMap.Add(FoundViewInfo.ScreenId, ScreenViewModel);
+		bRebindCurrentScreenWidget = true;
+		CreatedViewModel = ScreenViewModel;
+	}
+
+	if (ScreenInitialData.InitializeViewModelCallback)
+	{
+		ScreenInitialData.InitializeViewModelCallback(ScreenViewModel);
+	}
+
+	return CreatedViewModel;
+}
+
+void UUiScreenManager::PrepareScreenViewModel(FUiScreenRequest& ScreenRequest)
+{
+	ScreenRequest.bViewModelPrepared = true;
+
+	// The init callback may change screens and reallocate the pending requests, it's moved out of the request first
+	const uint32 RequestId = ScreenRequest.RequestId;
+	const FScreenInitialData ViewModelInitialData(ScreenRequest.InitialData.ScreenTag, ScreenRequest.InitialData.bCleanUpExistingScreens,
+		MoveTemp(ScreenRequest.InitialData.InitializeViewModelCallback), nullptr);
+
+	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ViewModelInitialData.ScreenTag);
+	UScreenViewModel* CreatedViewModel = FoundViewInfo ? CreateOrReuseScreenViewModel(ViewModelInitialData, *FoundViewInfo) : nullptr;
+
+	FUiScreenRequest* PreparedScreenRequest = FindPendingScreenRequest(RequestId);
+	if (!PreparedScreenRequest)
+	{
+		return;
+	}
+
+	PreparedScreenRequest->Timing.ViewModelCreatedTime = FPlatformTime::Seconds();
+	if (!CreatedViewModel)
+	{
+		// Reused view models are ready unless their previous screen was displayed after the ready timeout, that one is awaited again
+		UScreenViewModel* ReusedViewModel = GetScreenViewModel(ViewModelInitialData.ScreenTag);
+		if (!IsValid(ReusedViewModel) || ReusedViewModel->IsReady())
+		{
+			PreparedScreenRequest->bViewModelReady = true;
+			PreparedScreenRequest->Timing.ViewModelReadyTime = PreparedScreenRequest->Timing.ViewModelCreatedTime;
+			return;
+		}
+
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Reused view model of %s is still initializing"), __FUNCTION__, *ViewModelInitialData.ScreenTag.ToString());
+
+		AwaitScreenViewModel(*PreparedScreenRequest, *ReusedViewModel);
+		return;
+	}
+
+	TFuture<void> InitFuture = CreatedViewModel->InitAsync();
+	if (InitFuture.IsReady())
+	{
+		CreatedViewModel->CompleteAsyncInit();
+		PreparedScreenRequest->bViewModelReady = true;
+		PreparedScreenRequest->Timing.ViewModelReadyTime = FPlatformTime::Seconds();
+		return;
+	}
+
+	InitFuture.Then([WeakThis = TWeakObjectPtr<UUiScreenManager>(this), WeakViewModel = TWeakObjectPtr<UScreenViewModel>(CreatedViewModel)](TFuture<void>)
+	{
+		// The future can be fulfilled on a worker thread, results are committed on the game thread
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakViewModel]()
+		{
+			UScreenViewModel* ScreenViewModel = WeakViewModel.Get();
+			if (!ScreenViewModel)
+			{
+				return;
+			}
+
+			ScreenViewModel->CompleteAsyncInit();
+
+			if (UUiScreenManager* UiScreenManager = WeakThis.Get())
+			{
+				UiScreenManager->OnScreenViewModelInitialized(ScreenViewModel);
+			}
+		});
+	});
+
+	// Future might have been fulfilled in the meantime, the game thread task marks the request ready then
+	AwaitScreenViewModel(*PreparedScreenRequest, *CreatedViewModel);
+}
+
+void UUiScreenManager::AwaitScreenViewModel(FUiScreenRequest& ScreenRequest, UScreenViewModel& ScreenViewModel)
+{
+	const float ViewModelReadyTimeout = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetViewModelReadyTimeout();
+	if (ViewModelReadyTimeout <= 0.f)
+	{
+		ScreenRequest.bViewModelReady = true;
+		ScreenRequest.Timing.ViewModelReadyTime = FPlatformTime::Seconds();
+		return;
+	}
+
+	UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Request %u waits for the view model of %s"), __FUNCTION__, ScreenRequest.RequestId,
+		*ScreenRequest.InitialData.ScreenTag.ToString());
+
+	ScreenRequest.AwaitedViewModel = &ScreenViewModel;
+	ScreenRequest.ViewModelReadyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this,
+		[this, RequestId = ScreenRequest.RequestId](float)
+		{
+			OnScreenViewModelReady(RequestId, true);
+			return false;
+		}), ViewModelReadyTimeout);
+}
+
+void UUiScreenManager::OnScreenViewModelInitialized(const UScreenViewModel* ScreenViewModel)
+{
+	TArray<uint32> ReadyRequestIds;
+	for (const FUiScreenRequest& PendingScreenRequest : PendingScreenRequests)
+	{
+		if (!PendingScreenRequest.bViewModelReady && PendingScreenRequest.AwaitedViewModel == ScreenViewModel)
+		{
+			ReadyRequestIds.Add(PendingScreenRequest.RequestId);
+		}
+	}
+
+	for (const uint32 RequestId : ReadyRequestIds)
+	{
+		OnScreenViewModelReady(RequestId, false);
+	}
+}
+
+void UUiScreenManager::OnScreenViewModelReady(const uint32 RequestId, const bool bTimedOut)
+{
+	FUiScreenRequest* ScreenRequest = FindPendingScreenRequest(RequestId);
+	if (!ScreenRequest || ScreenRequest->bViewModelReady)
+	{
+		return;
+	}
+
+	if (bTimedOut)
+	{
+		UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs View model of %s isn't ready after %.2f s, the screen is displayed anyway"), __FUNCTION__,
+			*ScreenRequest->InitialData.ScreenTag.ToString(), UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetViewModelReadyTimeout());
+	}
+	else
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ScreenRequest->ViewModelReadyTickerHandle);
+	}
+
+	ScreenRequest->ViewModelReadyTickerHandle.Reset();
+	ScreenRequest->AwaitedViewModel.Reset();
+	ScreenRequest->bViewModelReady = true;
+	ScreenRequest->Timing.ViewModelReadyTime = FPlatformTime::Seconds();
+	DisplayLoadedScreenRequests();
+}
+
+void UUiScreenManager::BroadcastScreenChange(const FGameplayTag PreviousScreenTag, const FGameplayTag CurrentScreenTag) const
+{
+	OnUiScreenChanged.Broadcast(PreviousScreenTag, CurrentScreenTag);
+	OnUiScreenChanged_BP.Broadcast(PreviousScreenTag, CurrentScreenTag);
+}
+
+void UUiScreenManager::ChangeUiScreen(FScreenInitialData ScreenInitialData)
+{
+	// Rejected requests must not supersede valid pending ones, screens aren't known yet during the warm-up
+	if (IsReadyForScreenChanges() && !ValidateScreenRequest(ScreenInitialData))
+	{
+		return;
+	}
+
+	const uint32 RequestId = NextScreenRequestId++;
+	UI_SCREEN_TRACE_EVENT(TEXT("UiScreen Request %s #%u"), *ScreenInitialData.ScreenTag.ToString(), RequestId);
+	EnqueueScreenRequest(FUiScreenRequest(RequestId, MoveTemp(ScreenInitialData)));
+
+	if (!IsReadyForScreenChanges())
+	{
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Warm-up in progress, request %u is queued"), __FUNCTION__, RequestId);
+		return;
+	}
+
+	if (!StartScreenRequest(RequestId))
+	{
+		PendingScreenRequests.RemoveAll([RequestId](const FUiScreenRequest& ScreenRequest) { return ScreenRequest.RequestId == RequestId; });
+	}
+
+	DisplayLoadedScreenRequests();
+}
+
+bool UUiScreenManager::ValidateScreenRequest(const FScreenInitialData& ScreenInitialData)
+{
+	const FGameplayTag ScreenTag = ScreenInitialData.ScreenTag;
+	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenTag);
+	if (!FoundViewInfo)
+	{
+		return false;
+	}
+
+	if (ScreenTag == CurrentScreenState.ScreenId && !ScreenInitialData.bCleanUpExistingScreens)
+	{
+		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs New screen id %s is the same as current one, change aborted"), __FUNCTION__, *ScreenTag.ToString());
+		return false;
+	}
+
+	if (FoundViewInfo->ScreenClass.IsNull())
+	{
+		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Screen class isn't set up for screen %s"), __FUNCTION__, *ScreenTag.ToString());
+		return false;
+	}
+
+	return true;
+}
+
+bool UUiScreenManager::StartScreenRequest(const uint32 RequestId)
+{
+	FUiScreenRequest* ScreenRequest = FindPendingScreenRequest(RequestId);
+	if (!ScreenRequest || ScreenRequest->bLoadStarted)
+	{
+		return true;
+	}
+
+	ScreenRequest->bLoadStarted = true;
+	ScreenRequest->Timing.LoadStartTime = FPlatformTime::Seconds();
+	const FGameplayTag ScreenTag = ScreenRequest->InitialData.ScreenTag;
+
+	// Requests queued during the warm-up are validated only now
+	if (!ValidateScreenRequest(ScreenRequest->InitialData))
+	{
+		return false;
+	}
+
+	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(ScreenTag);
+
+	// A completed prefetch already holds the whole bundle, the request takes its handle over
+	if (FPrefetchedScreen* PrefetchedScreen = PrefetchedScreens.Find(ScreenTag); PrefetchedScreen && PrefetchedScreen->Handle && PrefetchedScreen->Handle->HasLoadCompleted())
+	{
+		ScreenRequest->StreamingHandle = MoveTemp(PrefetchedScreen->Handle);
+		ScreenRequest->bAssetsLoaded = true;
+		ScreenRequest->Timing.LoadCompleteTime = ScreenRequest->Timing.LoadStartTime;
+
+		PrefetchedBytes -= PrefetchedScreen->SizeBytes;
+		PrefetchedScreens.Remove(ScreenTag);
+		return true;
+	}
+	else if (PrefetchedScreen && PrefetchedScreen->Handle && PrefetchedScreen->Handle->IsLoadingInProgress())
+	{
+		// A prefetch still in flight streams the same bundle, the request takes its handle over instead of requesting the assets again
+		TSharedPtr<FStreamableHandle> PrefetchHandle = MoveTemp(PrefetchedScreen->Handle);
+		PrefetchedBytes -= PrefetchedScreen->SizeBytes;
+		PrefetchedScreens.Remove(ScreenTag);
+
+		UI_SCREEN_TRACE_BEGIN_REGION(TEXT("UiScreen Load %s #%u"), *ScreenTag.ToString(), RequestId);
+
+		// Replaces the prefetch completion callback, the prefetch bookkeeping is already gone
+		PrefetchHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ThisClass::OnScreenRequestAssetsLoaded, RequestId));
+
+		// The user waits for it now, the prefetch mustn't keep streaming behind everything else
+		UiStreamingHelper::RaiseLoadPriority(*PrefetchHandle, UiStreamingHelper::InteractiveScreenPriority);
+
+		ScreenRequest->StreamingHandle = MoveTemp(PrefetchHandle);
+		return true;
+	}
+
+	// Widget class, view model class and dependencies are streamed as one bundle so the completion callback never has to load synchronously
+	TArray<FSoftObjectPath> ScreenAssetPaths;
+	UiScreenManagerHelper::GatherScreenAssetPaths(*FoundViewInfo, ScreenAssetPaths);
+
+	const bool bAllAssetsResident = Algo::AllOf(ScreenAssetPaths, [](const FSoftObjectPath& AssetPath)
+	{
+		return AssetPath.ResolveObject() != nullptr;
+	});
+
+	if (bAllAssetsResident)
+	{
+		ScreenRequest->bAssetsLoaded = true;
+		ScreenRequest->Timing.LoadCompleteTime = ScreenRequest->Timing.LoadStartTime;
+		return true;
+	}
+
+	UI_SCREEN_TRACE_BEGIN_REGION(TEXT("UiScreen Load %s #%u"), *ScreenTag.ToString(), RequestId);
+
+	TSharedPtr<FStreamableHandle> StreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(ScreenAssetPaths),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnScreenRequestAssetsLoaded, RequestId),
+		UiStreamingHelper::InteractiveScreenPriority
+		);
+
+	// Request might have been displayed already if the load completed synchronously
+	if (FUiScreenRequest* StartedScreenRequest = FindPendingScreenRequest(RequestId))
+	{
+		StartedScreenRequest->StreamingHandle = MoveTemp(StreamingHandle);
+	}
+
+	return true;
+}
+
+void UUiScreenManager::ProcessPendingScreenRequests()
+{
+	if (!IsReadyForScreenChanges())
+	{
+		return;
+	}
+
+	// Layers weren't known while the warm-up was in progress, coalesce again now that they are
+	TArray<FUiScreenRequest> QueuedScreenRequests = MoveTemp(PendingScreenRequests);
+	PendingScreenRequests.Reset();
+	for (FUiScreenRequest& QueuedScreenRequest : QueuedScreenRequests)
+	{
+		EnqueueScreenRequest(MoveTemp(QueuedScreenRequest));
+	}
+
+	TArray<uint32> RequestIds;
+	Algo::Transform(PendingScreenRequests, RequestIds, &FUiScreenRequest::RequestId);
+	for (const uint32 RequestId : RequestIds)
+	{
+		if (!StartScreenRequest(RequestId))
+		{
+			PendingScreenRequests.RemoveAll([RequestId](const FUiScreenRequest& ScreenRequest) { return ScreenRequest.RequestId == RequestId; });
+		}
+	}
+
+	DisplayLoadedScreenRequests();
+}
+
+void UUiScreenManager::DisplayLoadedScreenRequests()
+{
+	// Requests left after coalescing target increasingly higher layers, displaying out of order would let a lower layer clear a newer screen
+	while (!PendingScreenRequests.IsEmpty() && PendingScreenRequests[0].bAssetsLoaded)
+	{
+		// View models are created in request order, right before their screens would be displayed
+		if (!PendingScreenRequests[0].bViewModelPrepared)
+		{
+			PrepareScreenViewModel(PendingScreenRequests[0]);
+
+			// The view model init callback might have changed the pending requests
+			continue;
+		}
+
+		if (!PendingScreenRequests[0].bViewModelReady)
+		{
+			break;
+		}
+
+		FUiScreenRequest ScreenRequest = MoveTemp(PendingScreenRequests[0]);
+		PendingScreenRequests.RemoveAt(0);
+
+		DisplayScreenRequest(MoveTemp(ScreenRequest));
+	}
+
+	BeginOutgoingTransitionForNextRequest();
+}
+
+void UUiScreenManager::BeginOutgoingTransitionForNextRequest()
+{
+	UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	if (!IsValid(MainLayoutWidget))
+	{
+		return;
+	}
+
+	if (PendingScreenRequests.IsEmpty())
+	{
+		// Requests dropped before their display would leave their placeholders blank
+		MainLayoutWidget->RemoveLayerPlaceholders();
+		return;
+	}
+
+	FUiScreenRequest& NextScreenRequest = PendingScreenRequests[0];
+	if (!NextScreenRequest.bLoadStarted || NextScreenRequest.bOutgoingTransitionStarted)
+	{
+		return;
+	}
+
+	const FUiScreenInfo* FoundViewInfo = GetUiScreenInfo(NextScreenRequest.InitialData.ScreenTag);
+	if (!FoundViewInfo)
+	{
+		return;
+	}
+
+	UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Transitioning out while request %u for %s loads"), __FUNCTION__, NextScreenRequest.RequestId,
+		*NextScreenRequest.InitialData.ScreenTag.ToString());
+
+	NextScreenRequest.bOutgoingTransitionStarted = true;
+	NextScreenRequest.Timing.TransitionStartTime = FPlatformTime::Seconds();
+	MainLayoutWidget->BeginOutgoingTransition(*FoundViewInfo, NextScreenRequest.InitialData.bCleanUpExistingScreens);
+}
+
+FUiScreenRequest* UUiScreenManager::FindPendingScreenRequest(const uint32 RequestId)
+{
+	return PendingScreenRequests.FindByPredicate([RequestId](const FUiScreenRequest& ScreenRequest)
+	{
+		return ScreenRequest.RequestId == RequestId;
+	});
+}
+
+void UUiScreenManager::CancelPendingScreenRequests()
+{
+	for (FUiScreenRequest& PendingScreenRequest : PendingScreenRequests)
+	{
+		if (PendingScreenRequest.StreamingHandle && !PendingScreenRequest.bAssetsLoaded)
+		{
+			UI_SCREEN_TRACE_END_REGION(TEXT("UiScreen Load %s #%u"), *PendingScreenRequest.InitialData.ScreenTag.ToString(), PendingScreenRequest.RequestId);
+		}
+
+		if (PendingScreenRequest.ViewModelReadyTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(PendingScreenRequest.ViewModelReadyTickerHandle);
+		}
+
+		UiStreamingHelper::CancelOrReleaseHandle(PendingScreenRequest.StreamingHandle);
+	}
+
+	PendingScreenRequests.Empty();
+}
+
+void UUiScreenManager::EnqueueScreenRequest(FUiScreenRequest&& ScreenRequest)
+{
+	const bool bCleanUpExistingScreens = ScreenRequest.InitialData.bCleanUpExistingScreens;
+	const int32 LayerIndex = GetLayerIndexForScreen(ScreenRequest.InitialData.ScreenTag);
+
+	bool bInheritCleanUp = false;
+	TArray<FGameplayTag> SkippedScreens;
+
+	for (int32 Index = 0; Index < PendingScreenRequests.Num();)
+	{
+		FUiScreenRequest& PendingRequest = PendingScreenRequests[Index];
+
+		bool bSuperseded = bCleanUpExistingScreens;
+		if (!bSuperseded && LayerIndex != INDEX_NONE)
+		{
+			const int32 PendingLayerIndex = GetLayerIndexForScreen(PendingRequest.InitialData.ScreenTag);
+			bSuperseded = PendingLayerIndex != INDEX_NONE && PendingLayerIndex >= LayerIndex;
+		}
+
+		if (!bSuperseded)
+		{
+			++Index;
+			continue;
+		}
+
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%hs Request %u for %s is superseded by %s"), __FUNCTION__, PendingRequest.RequestId,
+			*PendingRequest.InitialData.ScreenTag.ToString(), *ScreenRequest.InitialData.ScreenTag.ToString());
+
+		if (PendingRequest.StreamingHandle && !PendingRequest.bAssetsLoaded)
+		{
+			UI_SCREEN_TRACE_END_REGION(TEXT("UiScreen Load %s #%u"), *PendingRequest.InitialData.ScreenTag.ToString(), PendingRequest.RequestId);
+		}
+
+		UiStreamingHelper::CancelOrReleaseHandle(PendingRequest.StreamingHandle);
+
+		if (PendingRequest.ViewModelReadyTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(PendingRequest.ViewModelReadyTickerHandle);
+		}
+
+		// Everything requested before a cleanup is wiped from the history anyway
+		if (PendingRequest.InitialData.bCleanUpExistingScreens)
+		{
+			bInheritCleanUp = true;
+			SkippedScreens = MoveTemp(PendingRequest.SkippedScreens);
+		}
+		else
+		{
+			SkippedScreens.Append(MoveTemp(PendingRequest.SkippedScreens));
+		}
+
+		SkippedScreens.Add(PendingRequest.InitialData.ScreenTag);
+		PendingScreenRequests.RemoveAt(Index);
+	}
+
+	if (!bCleanUpExistingScreens)
+	{
+		ScreenRequest.InitialData.bCleanUpExistingScreens = bInheritCleanUp;
+		SkippedScreens.Append(MoveTemp(ScreenRequest.SkippedScreens));
+		ScreenRequest.SkippedScreens = MoveTemp(SkippedScreens);
+	}
+
+	PendingScreenRequests.Add(MoveTemp(ScreenRequest));
+}
+
+int32 UUiScreenManager::GetLayerIndexForScreen(const FGameplayTag ScreenTag)
+{
+	const UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	const int32* ScreenInfoIndex = ScreenInfoIndices.Find(ScreenTag);
+	if (!MainLayoutWidget || !ScreenInfoIndex || !ScreensData)
+	{
+		return INDEX_NONE;
+	}
+
+	return MainLayoutWidget->GetLayerIndex(ScreensData->Screens[*ScreenInfoIndex].LayerId);
+}
+
+void UUiScreenManager::GoToThePreviousUiScreen()
+{
+	if (CurrentScreenState.PreviousScreens.IsEmpty())
+	{
+		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Cannot go back to the previous screen, no previous screen cached"), __FUNCTION__);
+		return;
+	}
+
+	ChangeUiScreen(FScreenInitialData(CurrentScreenState.PreviousScreens.Last()));
+}
+
+void UUiScreenManager::AddMainLayoutToViewport(UMainUiLayoutWidget* LayoutWidget)
+{
+	UE_LOG(LogUiScreenFramework, Log, TEXT("%hs %s is adding the root layout %s to the viewport"), __FUNCTION__, *GetName(), *GetNameSafe(LayoutWidget));
+
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	check(IsValid(LocalPlayer));
+
+	const FLocalPlayerContext LocalPlayerContext = FLocalPlayerContext(LocalPlayer);
+	LayoutWidget->SetPlayerContext(LocalPlayerContext);
+	LayoutWidget->AddToPlayerScreen(MainLayoutWidgetZOrder);
+}
+
+void UUiScreenManager::RemoveMainLayoutFromViewport(UMainUiLayoutWidget& LayoutWidget)
+{
+	const TWeakPtr<SWidget> LayoutSlateWidget = LayoutWidget.GetCachedWidget();
+	if (LayoutSlateWidget.IsValid())
+	{
+		UE_LOG(LogUiScreenFramework, Log, TEXT("%s is removing root layout %s from the viewport"), *GetName(), *LayoutWidget.GetName());
+
+		LayoutWidget.RemoveFromParent();
+		if (LayoutSlateWidget.IsValid())
+		{
+			UE_LOG(LogUiScreenFramework, Log, TEXT("Root layout [%s] has been removed from the viewport, but other references to its"
+				" underlying Slate widget still exist. Noting in case we leak it."), *LayoutWidget.GetName());
+		}
+	}
+}
+
+FUiScreenInfo* UUiScreenManager::GetUiScreenInfo(const FGameplayTag ScreenTag)
+{
+	const int32* ScreenInfoIndex = ScreenInfoIndices.Find(ScreenTag);
+	if (!ScreenInfoIndex || !ScreensData)
+	{
+		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs ViewInfo with ScreenTag %s hasn't been found in View Data asset"), __FUNCTION__, *ScreenTag.ToString());
+		return nullptr;
+	}
+
+	return &ScreensData->Screens[*ScreenInfoIndex];
+}
+
+void UUiScreenManager::BuildScreenInfoLookup()
+{
+#if WITH_EDITOR
+	if (ScreensData)
+	{
+		ScreensData->OnScreensDataChanged.RemoveAll(this);
+	}
+#endif
+
+	// Asset is streamed during the warm-up, sync load only happens when settings point to a new asset in editor
+	const UUiScreenFrameworkSettings& ScreenFrameworkSettings = UiScreenManagerHelper::GetUiScreenFrameworkSettings();
+	ScreensData = ScreenFrameworkSettings.GetScreensDataSoftPtr().Get();
+#if !UE_BUILD_SHIPPING
+	if (UUiScreensData* OverrideScreensData = ScreensDataOverride.Get())
+	{
+		ScreensData = OverrideScreensData;
+	}
+#endif
+	if (!ScreensData)
+	{
+		ScreensData = ScreenFrameworkSettings.GetViewsData();
+	}
+	ScreenInfoIndices.Reset();
+
+	if (!ScreensData)
+	{
+		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs UI Screens Data asset isn't set in UiScreenFrameworkSettings"), __FUNCTION__);
+		return;
+	}
+
+#if WITH_EDITOR
+	ScreensData->OnScreensDataChanged.AddUObject(this, &UUiScreenManager::OnScreensDataChanged);
+#endif
+
+	const TArray<FUiScreenInfo>& Screens = ScreensData->Screens;
+	ScreenInfoIndices.Reserve(Screens.Num());
+	for (int32 Index = 0; Index < Screens.Num(); ++Index)
+	{
+		const FGameplayTag& ScreenId = Screens[Index].ScreenId;
+		if (ScreenInfoIndices.Contains(ScreenId))
+		{
+			UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs Screen %s is defined more than once in %s, the first entry is used"), __FUNCTION__, *ScreenId.ToString(),
+				*GetNameSafe(ScreensData));
+			continue;
+		}
+
+		ScreenInfoIndices.Add(ScreenId, Index);
+	}
+}
+
+#if WITH_EDITOR
+void UUiScreenManager::OnScreensDataChanged(const UUiScreensData* ChangedScreensData)
+{
+	BuildScreenInfoLookup();
+}
+
+void UUiScreenManager::OnFrameworkSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	BuildScreenInfoLookup();
+}
+#endif
+
+UScreenViewModel* UUiScreenManager::GetScreenViewModel(const FGameplayTag ScreenTag)
+{
+	TObjectPtr<UScreenViewModel>* ScreenViewModelPtr = ScreenViewModelsMap.Find(ScreenTag);
+	if (!ScreenViewModelPtr)
+	{
+		return nullptr;
 	}
 
 	return *ScreenViewModelPtr;
@@ -389,10 +1500,184 @@ UCommonActivatableWidget* UUiScreenManager::GetScreenWidget() const
 	return MainLayoutWidget->GetCurrentScreenWidget();
 }
 
-void UUiScreenManager::CallInitializeScreenWidgetCallback(UCommonActivatableWidget* ScreenWidget)
+void UUiScreenManager::CallInitializeScreenWidgetCallback(UCommonActivatableWidget* ScreenWidget, const FGameplayTag LayerId)
+{
+	// The widget of the pending screen change is complete
+	const FUiScreenInfo* PendingChangeScreenInfo = PendingScreenChange && ScreenWidget ? GetUiScreenInfo(PendingScreenChange->ScreenTag) : nullptr;
+	if (PendingChangeScreenInfo && PendingChangeScreenInfo->LayerId == LayerId && ScreenWidget->GetClass() == PendingChangeScreenInfo->ScreenClass.Get())
+	{
+		CommitPendingScreenChange();
+	}
+
+	// Kept alive and stacked widgets aren't reconstructed, so the resolver doesn't run again for them
+	if (bRebindCurrentScreenWidget && ScreenWidget && LayerId == CurrentScreenState.LayerId)
+	{
+		bRebindCurrentScreenWidget = false;
+		UScreenViewModel* CurrentScreenViewModel = GetScreenViewModel(CurrentScreenState.ScreenId);
+		if (CurrentScreenViewModel && ViewModelHelper::GetMvvmViewExtensionFromWidget(ScreenWidget))
+		{
+			ViewModelHelper::SetViewModel(ScreenWidget, CurrentScreenViewModel);
+		}
+	}
+
+	if (const TFunction<void(UCommonActivatableWidget*)>* InitializeScreenWidgetCallback = InitializeScreenWidgetCallbacks.Find(LayerId))
+	{
+		if (*InitializeScreenWidgetCallback)
+		{
+			(*InitializeScreenWidgetCallback)(ScreenWidget);
+		}
+	}
+
+	// Layers also report widgets they transition back to, only the requested screen completes the navigation
+	const FUiScreenNavigationTiming* PendingTiming = ActivationPendingTimings.Find(LayerId);
+	const FUiScreenInfo* PendingScreenInfo = PendingTiming && ScreenWidget ? GetUiScreenInfo(PendingTiming->ScreenTag) : nullptr;
+	if (PendingScreenInfo && ScreenWidget->GetClass() == PendingScreenInfo->ScreenClass.Get())
+	{
+		FUiScreenNavigationTiming Timing = ActivationPendingTimings.FindAndRemoveChecked(LayerId);
+		Timing.ActivatedTime = FPlatformTime::Seconds();
+		if (Timing.WidgetConstructedTime <= 0.0)
+		{
+			Timing.WidgetConstructedTime = Timing.ActivatedTime;
+		}
+
+		RecordNavigation(Timing);
+	}
+}
+
+void UUiScreenManager::OnLayerWidgetAdded(UCommonActivatableWidget& AddedWidget, const FGameplayTag LayerId)
+{
+	// Incrementally constructed screens are added once their widget is complete, not when the layer was asked for them
+	FUiScreenNavigationTiming* PendingTiming = ActivationPendingTimings.Find(LayerId);
+	const FUiScreenInfo* PendingScreenInfo = PendingTiming ? GetUiScreenInfo(PendingTiming->ScreenTag) : nullptr;
+	if (PendingScreenInfo && PendingTiming->WidgetConstructedTime <= 0.0 && AddedWidget.GetClass() == PendingScreenInfo->ScreenClass.Get())
+	{
+		PendingTiming->WidgetConstructedTime = FPlatformTime::Seconds();
+	}
+}
+
+void UUiScreenManager::RecordNavigation(const FUiScreenNavigationTiming& Timing)
+{
+	FUiScreenNavigationStats& ScreenStats = NavigationStats.FindOrAdd(Timing.ScreenTag);
+	ScreenStats.AddSample(Timing);
+
+	const double TotalMs = Timing.GetTotalMs();
+	UI_SCREEN_TRACE_EVENT(TEXT("UiScreen Activated %s"), *Timing.ScreenTag.ToString());
+	CSV_CUSTOM_STAT(UiScreenFramework, NavigationMs, TotalMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(UiScreenFramework, NavigationLoadMs, Timing.GetLoadMs(), ECsvCustomStatOp::Set);
+
+	SET_FLOAT_STAT(STAT_UiScreenLastNavigationMs, TotalMs);
+	SET_FLOAT_STAT(STAT_UiScreenLastNavigationLoadMs, Timing.GetLoadMs());
+	SET_FLOAT_STAT(STAT_UiScreenLastNavigationViewModelMs, Timing.GetViewModelMs());
+	SET_FLOAT_STAT(STAT_UiScreenLastNavigationConstructionMs, Timing.GetConstructionMs());
+	SET_FLOAT_STAT(STAT_UiScreenLastNavigationActivationMs, Timing.GetActivationMs());
+
+	// Screens differ too much for the last navigation alone to tell which of them regressed
+#if STATS
+	if (!ScreenStats.MeanStatId.IsValidStat())
+	{
+		ScreenStats.MeanStatId = FDynamicStats::CreateStatIdDouble<FStatGroup_STATGROUP_UiScreenFramework>(FString::Printf(TEXT("%s Navigation Mean (ms)"),
+			*Timing.ScreenTag.ToString()));
+		ScreenStats.P95StatId = FDynamicStats::CreateStatIdDouble<FStatGroup_STATGROUP_UiScreenFramework>(FString::Printf(TEXT("%s Navigation P95 (ms)"),
+			*Timing.ScreenTag.ToString()));
+	}
+	FThreadStats::AddMessage(ScreenStats.MeanStatId.GetName(), EStatOperation::Set, ScreenStats.GetMeanMs());
+	FThreadStats::AddMessage(ScreenStats.P95StatId.GetName(), EStatOperation::Set, ScreenStats.GetPercentileMs(0.95));
+#endif
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(FName(*FString::Printf(TEXT("NavigationMs/%s"), *Timing.ScreenTag.ToString())), CSV_CATEGORY_INDEX(UiScreenFramework), TotalMs,
+		ECsvCustomStatOp::Set);
+#endif
+
+	const float NavigationBudgetMs = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetNavigationBudgetMs();
+	if (NavigationBudgetMs > 0.f && TotalMs > NavigationBudgetMs)
+	{
+		UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs Navigation to %s took %.2f ms, over the %.2f ms budget (load %.2f ms, view model %.2f ms, construction %.2f ms, activation %.2f ms)"),
+			__FUNCTION__, *Timing.ScreenTag.ToString(), TotalMs, NavigationBudgetMs, Timing.GetLoadMs(), Timing.GetViewModelMs(), Timing.GetConstructionMs(),
+			Timing.GetActivationMs());
+	}
+	else
+	{
+		UE_LOG(LogUiScreenFramework, Verbose, TEXT("%hs Navigation to %s took %.2f ms"), __FUNCTION__, *Timing.ScreenTag.ToString(), TotalMs);
+	}
+}
+
+void UUiScreenManager::DumpNavigationStats(const bool bWriteCsv) const
+{
+	FString Csv = TEXT("Screen,Count,MeanMs,P95Ms,MaxMs,MeanLoadMs,MeanViewModelMs,MeanConstructionMs,MeanActivationMs\n");
+	for (const auto& [ScreenTag, ScreenStats] : NavigationStats)
+	{
+		const double MeanLoadMs = ScreenStats.GetMeanStageMs(&FUiScreenNavigationSample::LoadMs);
+		const double MeanViewModelMs = ScreenStats.GetMeanStageMs(&FUiScreenNavigationSample::ViewModelMs);
+		const double MeanConstructionMs = ScreenStats.GetMeanStageMs(&FUiScreenNavigationSample::ConstructionMs);
+		const double MeanActivationMs = ScreenStats.GetMeanStageMs(&FUiScreenNavigationSample::ActivationMs);
+
+		UE_LOG(LogUiScreenFramework, Display, TEXT("%s: count %d, mean %.2f ms, p95 %.2f ms, max %.2f ms (load %.2f ms, view model %.2f ms, construction %.2f ms, activation %.2f ms)"),
+			*ScreenTag.ToString(), ScreenStats.Count, ScreenStats.GetMeanMs(), ScreenStats.GetPercentileMs(0.95), ScreenStats.MaxMs, MeanLoadMs, MeanViewModelMs,
+			MeanConstructionMs, MeanActivationMs);
+
+		Csv += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n"), *ScreenTag.ToString(), ScreenStats.Count, ScreenStats.GetMeanMs(),
+			ScreenStats.GetPercentileMs(0.95), ScreenStats.MaxMs, MeanLoadMs, MeanViewModelMs, MeanConstructionMs, MeanActivationMs);
+	}
+
+	if (bWriteCsv)
+	{
+		const FString CsvPath = FPaths::ProfilingDir() / TEXT("UiScreenNavigation") / FString::Printf(TEXT("NavigationStats-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			UE_LOG(LogUiScreenFramework, Display, TEXT("%hs Navigation stats written to %s"), __FUNCTION__, *CsvPath);
+		}
+		else
+		{
+			UE_LOG(LogUiScreenFramework, Error, TEXT("%hs Failed to write navigation stats to %s"), __FUNCTION__, *CsvPath);
+		}
+	}
+}
+
+void UUiScreenManager::ResetNavigationStats()
+{
+	NavigationStats.Empty();
+}
+
+#if !UE_BUILD_SHIPPING
+bool UUiScreenManager::IsNavigationIdle() const
 {
-	if (InitializeScreenWidgetCallback)
+	const UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget;
+	return PendingScreenRequests.IsEmpty() && (!IsValid(MainLayoutWidget) || (!MainLayoutWidget->IsAnyLayerTransitioning() && !MainLayoutWidget->IsAnyLayerConstructing()));
+}
+
+void UUiScreenManager::SetScreensDataOverride(UUiScreensData* InScreensData)
+{
+	CancelPendingScreenRequests();
+
+	if (UMainUiLayoutWidget* MainLayoutWidget = MainLayoutWidgetInfo.MainLayoutWidget)
+	{
+		MainLayoutWidget->ClearAllLayers();
+	}
+
+	CurrentScreenState = FUiScreenState();
+	PendingScreenChange.Reset();
+	UiStreamingHelper::CancelOrReleaseHandle(DisplayedScreenHandle);
+	InitializeScreenWidgetCallbacks.Empty();
+	ActivationPendingTimings.Empty();
+	bRebindCurrentScreenWidget = false;
+
+	CleanupAllScreenViewModels();
+	FlushDeferredTeardown();
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PrefetchTimerHandle);
+	}
+
+	for (auto& [PrefetchedScreenTag, PrefetchedScreen] : PrefetchedScreens)
 	{
-		InitializeScreenWidgetCallback(ScreenWidget);
+		UiStreamingHelper::CancelOrReleaseHandle(PrefetchedScreen.Handle);
 	}
+
+	PrefetchedScreens.Empty();
+	PrefetchedBytes = 0;
+
+	ScreensDataOverride = InScreensData;
+	BuildScreenInfoLookup();
 }
+#endif
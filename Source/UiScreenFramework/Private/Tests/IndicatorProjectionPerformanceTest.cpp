@@ -0,0 +1,245 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Enums/IndicatorProjectionMode.h"
+#include "Helpers/IndicatorProjectionHelper.h"
+#include "SceneView.h"
+
+namespace IndicatorProjectionPerformanceTest
+{
+	/** Number of synthetic indicators, iterations cycle over them. */
+	constexpr int32 NumSamples = 4096;
+
+	constexpr int32 Iterations = 100;
+	constexpr int32 Seed = 0;
+
+	constexpr int32 NumModes = static_cast<int32>(EIndicatorProjectionMode::ActorScreenBoundingBox) + 1;
+
+	/** Largest screen space difference, in pixels, still considered to agree with the engine projection. */
+	constexpr double AgreementTolerance = 0.01;
+
+	/** Keeps the results alive, so the measured loops aren't optimized away. */
+	volatile double Sink = 0.0;
+
+	FSceneViewProjectionData MakeProjectionData(const FIntRect& ViewRect)
+	{
+		FSceneViewProjectionData ProjectionData;
+		ProjectionData.ViewOrigin = FVector(0.0, 0.0, 170.0);
+		// Rotation followed by the swap from the world (X forward, Z up) to the view (Z forward, Y up) axes
+		ProjectionData.ViewRotationMatrix = FInverseRotationMatrix(FRotator(-10.0, 30.0, 0.0)) * FMatrix(
+			FPlane(0.0, 0.0, 1.0, 0.0),
+			FPlane(1.0, 0.0, 0.0, 0.0),
+			FPlane(0.0, 1.0, 0.0, 0.0),
+			FPlane(0.0, 0.0, 0.0, 1.0));
+		ProjectionData.ProjectionMatrix = FReversedZPerspectiveMatrix(FMath::DegreesToRadians(45.f), ViewRect.Width(), ViewRect.Height(), 10.f);
+		ProjectionData.SetViewRectangle(ViewRect);
+		return ProjectionData;
+	}
+
+	/** Indicators of every projection mode, half of them clamped to the screen edge marker track, as the canvas gathers them. */
+	TArray<FIndicatorProjectionInput> MakeProjectionInputs()
+	{
+		// Points all around the camera, so some of them are behind it or off screen and have to be clamped
+		FRandomStream RandomStream(Seed);
+		TArray<FIndicatorProjectionInput> ProjectionInputs;
+		ProjectionInputs.Reserve(NumSamples);
+		for (int32 Index = 0; Index < NumSamples; ++Index)
+		{
+			FIndicatorProjectionInput& ProjectionInput = ProjectionInputs.AddDefaulted_GetRef();
+			const FVector Point(RandomStream.FRandRange(-20000.0, 20000.0), RandomStream.FRandRange(-20000.0, 20000.0), RandomStream.FRandRange(-500.0, 3000.0));
+			const FVector Extent(RandomStream.FRandRange(20.0, 200.0), RandomStream.FRandRange(20.0, 200.0), RandomStream.FRandRange(50.0, 300.0));
+			ProjectionInput.ProjectionMode = static_cast<EIndicatorProjectionMode>(Index % NumModes);
+			ProjectionInput.BoundingBox = FBox(Point - Extent, Point + Extent);
+			ProjectionInput.Center = Point;
+			ProjectionInput.WorldPositionOffset = FVector(0.0, 0.0, 20.0);
+			ProjectionInput.BoundingBoxAnchor = FVector(RandomStream.FRand(), RandomStream.FRand(), RandomStream.FRand());
+			ProjectionInput.ScreenSpaceOffset = FVector2D(RandomStream.FRandRange(-20.0, 20.0), RandomStream.FRandRange(-20.0, 20.0));
+			ProjectionInput.bClampToScreen = (Index / NumModes) % 2 == 0;
+		}
+		return ProjectionInputs;
+	}
+
+	/** Screen positions inside, on and outside of the screen edge marker track. */
+	TArray<FVector2D> MakeScreenPositions(const FVector2f& ScreenSize)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<FVector2D> ScreenPositions;
+		ScreenPositions.Reserve(NumSamples);
+		for (int32 Index = 0; Index < NumSamples; ++Index)
+		{
+			ScreenPositions.Emplace(RandomStream.FRandRange(-ScreenSize.X, 2.0 * ScreenSize.X), RandomStream.FRandRange(-ScreenSize.Y, 2.0 * ScreenSize.Y));
+		}
+		return ScreenPositions;
+	}
+
+	/**
+	 * Projection of the input done the way it was before the view was shared, with the engine projecting every point on its own.
+	 * Clamping isn't under test here, it is applied the same way to both results.
+	 */
+	bool ReferenceProjectInput(const FIndicatorProjectionInput& ProjectionInput, const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize,
+		const FScreenEdgeMarkersTrackArea& TrackArea, FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack, float& OutTrackArrowAngle)
+	{
+		const FBox& BoundingBox = ProjectionInput.BoundingBox;
+
+		bool bWasProjectionOk;
+		switch (ProjectionInput.ProjectionMode)
+		{
+		case EIndicatorProjectionMode::FixedPoint:
+		case EIndicatorProjectionMode::ActorRoot:
+			bWasProjectionOk = ULocalPlayer::GetPixelPoint(ProjectionData, ProjectionInput.Center + ProjectionInput.WorldPositionOffset, OutScreenPosition, &ScreenSize);
+			break;
+		case EIndicatorProjectionMode::ActorBoundingBox:
+		case EIndicatorProjectionMode::ActorSkeletalMeshBoundingBox:
+			bWasProjectionOk = ULocalPlayer::GetPixelPoint(ProjectionData,
+				ProjectionInput.Center + BoundingBox.GetSize() * (ProjectionInput.BoundingBoxAnchor - FVector(0.5)) + ProjectionInput.WorldPositionOffset,
+				OutScreenPosition, &ScreenSize);
+			break;
+		case EIndicatorProjectionMode::ActorScreenBoundingBox:
+		{
+			FVector2D LowerLeft, UpperRight;
+			bWasProjectionOk = ULocalPlayer::GetPixelBoundingBox(ProjectionData, BoundingBox, LowerLeft, UpperRight, &ScreenSize);
+			if (bWasProjectionOk)
+			{
+				OutScreenPosition.X = FMath::Lerp(LowerLeft.X, UpperRight.X, ProjectionInput.BoundingBoxAnchor.X);
+				OutScreenPosition.Y = FMath::Lerp(LowerLeft.Y, UpperRight.Y, ProjectionInput.BoundingBoxAnchor.Y);
+			}
+			break;
+		}
+		default:
+			check(false);
+			return false;
+		}
+
+		OutScreenPosition += ProjectionInput.ScreenSpaceOffset;
+
+		bOutIsOnTheTrack = false;
+		if (!ProjectionInput.bClampToScreen)
+		{
+			return bWasProjectionOk;
+		}
+
+		if (!bWasProjectionOk || !IndicatorProjectionHelper::IsInsideScreenEdgeMarkerTrack(OutScreenPosition, ScreenSize, TrackArea))
+		{
+			bOutIsOnTheTrack = true;
+			IndicatorProjectionHelper::ClampToScreenEdgeMarkerTrack(OutScreenPosition, ScreenSize, TrackArea, OutTrackArrowAngle);
+		}
+		return true;
+	}
+
+	/** Runs the function over all items for the given number of iterations and returns nanoseconds per call. */
+	template <typename ItemType, typename ProjectFunc>
+	double MeasureNs(const TArray<ItemType>& Items, ProjectFunc&& Project)
+	{
+		double Accumulated = 0.0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const ItemType& Item : Items)
+			{
+				FVector2D ScreenPosition = FVector2D::ZeroVector;
+				Accumulated += Project(Item, ScreenPosition) ? ScreenPosition.X : ScreenPosition.Y;
+			}
+		}
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Sink = Sink + Accumulated;
+		return Items.IsEmpty() ? 0.0 : ElapsedSeconds * 1.0e9 / (static_cast<double>(Iterations) * Items.Num());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIndicatorProjectionPerformanceTest, "UiScreenFramework.Performance.IndicatorProjection",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FIndicatorProjectionPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace IndicatorProjectionPerformanceTest;
+
+	const FIntRect ViewRect(0, 0, 1920, 1080);
+	const FVector2f ScreenSize(ViewRect.Width(), ViewRect.Height());
+	const FSceneViewProjectionData ProjectionData = MakeProjectionData(ViewRect);
+	const IndicatorProjectionHelper::FIndicatorProjectionView View(ProjectionData);
+	const FScreenEdgeMarkersTrackArea TrackArea;
+	const TArray<FIndicatorProjectionInput> ProjectionInputs = MakeProjectionInputs();
+	const TArray<FVector2D> ScreenPositions = MakeScreenPositions(ScreenSize);
+
+	auto ProjectReference = [&ProjectionData, &ScreenSize, &TrackArea](const FIndicatorProjectionInput& ProjectionInput, FVector2D& OutScreenPosition)
+	{
+		bool bIsOnTheTrack = false;
+		float TrackArrowAngle = 0.f;
+		return ReferenceProjectInput(ProjectionInput, ProjectionData, ScreenSize, TrackArea, OutScreenPosition, bIsOnTheTrack, TrackArrowAngle);
+	};
+	auto ProjectBatched = [&View, &ScreenSize, &TrackArea](const FIndicatorProjectionInput& ProjectionInput, FVector2D& OutScreenPosition)
+	{
+		bool bIsOnTheTrack = false;
+		float TrackArrowAngle = 0.f;
+		FVector WorldPosition;
+		return IndicatorProjectionHelper::ProjectInput(ProjectionInput, View, ScreenSize, TrackArea, OutScreenPosition, bIsOnTheTrack, TrackArrowAngle, WorldPosition);
+	};
+
+	for (int32 ModeIndex = 0; ModeIndex < NumModes; ++ModeIndex)
+	{
+		const EIndicatorProjectionMode ProjectionMode = static_cast<EIndicatorProjectionMode>(ModeIndex);
+		const FString ModeName = StaticEnum<EIndicatorProjectionMode>()->GetNameStringByValue(ModeIndex);
+		const TArray<FIndicatorProjectionInput> ModeInputs = ProjectionInputs.FilterByPredicate([ProjectionMode](const FIndicatorProjectionInput& ProjectionInput)
+		{
+			return ProjectionInput.ProjectionMode == ProjectionMode;
+		});
+
+		double MaxDifference = 0.0;
+		int32 Mismatches = 0;
+		for (const FIndicatorProjectionInput& ProjectionInput : ModeInputs)
+		{
+			FVector2D ReferencePosition = FVector2D::ZeroVector;
+			bool bReferenceIsOnTheTrack = false;
+			float ReferenceTrackArrowAngle = 0.f;
+			const bool bReferenceVisible = ReferenceProjectInput(ProjectionInput, ProjectionData, ScreenSize, TrackArea, ReferencePosition, bReferenceIsOnTheTrack,
+				ReferenceTrackArrowAngle);
+
+			FVector2D ScreenPosition = FVector2D::ZeroVector;
+			bool bIsOnTheTrack = false;
+			float TrackArrowAngle = 0.f;
+			FVector WorldPosition;
+			const bool bVisible = IndicatorProjectionHelper::ProjectInput(ProjectionInput, View, ScreenSize, TrackArea, ScreenPosition, bIsOnTheTrack, TrackArrowAngle,
+				WorldPosition);
+
+			Mismatches += bReferenceVisible != bVisible || bReferenceIsOnTheTrack != bIsOnTheTrack || ReferenceTrackArrowAngle != TrackArrowAngle ? 1 : 0;
+			if (bReferenceVisible && bVisible)
+			{
+				MaxDifference = FMath::Max(MaxDifference, FVector2D::Distance(ReferencePosition, ScreenPosition));
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("%s agrees with the engine projection: max difference %.5f px, %d visibility or track mismatches"), *ModeName, MaxDifference,
+			Mismatches), Mismatches == 0 && MaxDifference <= AgreementTolerance);
+
+		AddInfo(FString::Printf(TEXT("%s: %.2f ns engine projection, %.2f ns shared view"), *ModeName, MeasureNs(ModeInputs, ProjectReference),
+			MeasureNs(ModeInputs, ProjectBatched)));
+	}
+
+	// Timings are only reported, they depend on the machine and its load too much to be asserted
+	AddInfo(FString::Printf(TEXT("All modes, %d projections: %.2f ns engine projection, %.2f ns shared view"), Iterations * ProjectionInputs.Num(),
+		MeasureNs(ProjectionInputs, ProjectReference), MeasureNs(ProjectionInputs, ProjectBatched)));
+
+	AddInfo(FString::Printf(TEXT("IsInsideScreenEdgeMarkerTrack: %.2f ns"), MeasureNs(ScreenPositions,
+		[&ScreenSize, &TrackArea](const FVector2D& Position, FVector2D& OutScreenPosition)
+		{
+			OutScreenPosition = Position;
+			return IndicatorProjectionHelper::IsInsideScreenEdgeMarkerTrack(Position, ScreenSize, TrackArea);
+		})));
+
+	AddInfo(FString::Printf(TEXT("ClampToScreenEdgeMarkerTrack: %.2f ns"), MeasureNs(ScreenPositions,
+		[&ScreenSize, &TrackArea](const FVector2D& Position, FVector2D& OutScreenPosition)
+		{
+			OutScreenPosition = Position;
+			float TrackArrowAngle = 0.f;
+			IndicatorProjectionHelper::ClampToScreenEdgeMarkerTrack(OutScreenPosition, ScreenSize, TrackArea, TrackArrowAngle);
+			return TrackArrowAngle > 0.f;
+		})));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,527 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CommonActivatableWidget.h"
+#include "DataAssets/UiScreensData.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "GameplayTags/UiGameplayTags.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "NativeGameplayTags.h"
+#include "Subsystems/UiScreenManager.h"
+#include "Tests/AutomationCommon.h"
+#include "UObject/GCObject.h"
+#include "UObject/UObjectIterator.h"
+#include "UiScreenNavigationTestScreens.h"
+#include "ViewModels/ScreenViewModel.h"
+#include "Widgets/LayerWidget.h"
+#include "Widgets/MainUiLayoutWidget.h"
+
+namespace UiScreenNavigationPerformanceTest
+{
+	enum class EOperation : uint8
+	{
+		Change,
+		Back,
+		Cleanup,
+		Num
+	};
+
+	const TCHAR* LexToString(const EOperation Operation)
+	{
+		switch (Operation)
+		{
+		case EOperation::Change: return TEXT("ChangeUiScreen");
+		case EOperation::Back: return TEXT("GoToThePreviousUiScreen");
+		case EOperation::Cleanup: return TEXT("ChangeUiScreen (clean up)");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	constexpr int32 NumScreens = 100;
+	constexpr int32 Seed = 0;
+
+	/** Navigations of a run, can be changed with -UiScreenNavigationOperations=<Count>. */
+	constexpr int32 DefaultNumOperations = 2000;
+
+	/** Operation waiting longer than this is reported as stalled and ends the run. */
+	constexpr double OperationTimeoutSeconds = 10.0;
+
+	/** Live objects are counted every this many operations, iterating all objects is too slow to do it after each one. */
+	constexpr int32 LiveObjectSampleInterval = 50;
+
+	/** Frames waited after the teardown so the forced garbage collection runs before leaks are counted. */
+	constexpr int32 SettleFrames = 3;
+
+	/** Synthetic screen tags are registered once and reused by later runs, tags can't be unregistered while screens may refer to them. */
+	const FGameplayTag& GetSyntheticScreenTag(const int32 Index)
+	{
+		static TArray<TUniquePtr<FNativeGameplayTag>> SyntheticScreenTags;
+		while (SyntheticScreenTags.Num() <= Index)
+		{
+			const FName TagName(*FString::Printf(TEXT("UI.Screen.Benchmark.%d"), SyntheticScreenTags.Num()));
+			SyntheticScreenTags.Add(MakeUnique<FNativeGameplayTag>(UE_PLUGIN_NAME, UE_MODULE_NAME, TagName, TEXT("Synthetic screen of the navigation performance test"),
+				ENativeGameplayTagToken::PRIVATE_USE_MACRO_INSTEAD));
+		}
+
+		return SyntheticScreenTags[Index]->GetTag();
+	}
+
+	template <typename T>
+	int32 CountLiveObjects()
+	{
+		int32 Count = 0;
+		for (TObjectIterator<T> It; It; ++It)
+		{
+			++Count;
+		}
+		return Count;
+	}
+
+	struct FOperationSamples
+	{
+		/** Cost of the call itself, in milliseconds. */
+		TArray<double> CallMs;
+		/** Time until the manager is idle again, in milliseconds. */
+		TArray<double> CompletionMs;
+		TArray<int32> CompletionFrames;
+	};
+
+	double GetPercentile(TArray<double> Samples, const double Percentile)
+	{
+		if (Samples.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		Samples.Sort();
+		return Samples[FMath::Clamp(FMath::CeilToInt32(Percentile * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	}
+
+	double GetMean(const TArray<double>& Samples)
+	{
+		double Sum = 0.0;
+		for (const double Sample : Samples)
+		{
+			Sum += Sample;
+		}
+		return Samples.IsEmpty() ? 0.0 : Sum / Samples.Num();
+	}
+
+	UUiScreenManager* FindScreenManager()
+	{
+		if (!GEngine)
+		{
+			return nullptr;
+		}
+
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			const UWorld* World = WorldContext.World();
+			if (!World || (WorldContext.WorldType != EWorldType::Game && WorldContext.WorldType != EWorldType::PIE))
+			{
+				continue;
+			}
+
+			const UGameInstance* GameInstance = World->GetGameInstance();
+			const ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->GetFirstGamePlayer() : nullptr;
+			UUiScreenManager* UiScreenManager = LocalPlayer ? LocalPlayer->GetSubsystem<UUiScreenManager>() : nullptr;
+			if (UiScreenManager && UiScreenManager->IsReadyForScreenChanges())
+			{
+				return UiScreenManager;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Drives a scripted sequence of navigations through the screen manager of a local player, one at a time.
+	 * Synthetic screens are built from the test screen classes of the plugin under generated tags, on the plugin layers present in the main layout.
+	 * Forward navigations only target screens whose class isn't in their layer yet, otherwise the layer would just switch to the existing widget.
+	 * When every class is present the layers are cleared with a cleanup navigation instead.
+	 */
+	class FNavigationRun : public FGCObject
+	{
+	public:
+		FNavigationRun(FAutomationTestBase& InTest, UUiScreenManager& InUiScreenManager)
+			: Test(InTest)
+			, UiScreenManager(&InUiScreenManager)
+			, RandomStream(Seed)
+			, NumOperations(DefaultNumOperations)
+		{
+			Samples.SetNum(static_cast<int32>(EOperation::Num));
+		}
+
+		bool Start();
+
+		/** Advances the run by a frame, returns true once it's finished and its results are checked. */
+		bool Update();
+
+		//~ Begin FGCObject interface
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override { Collector.AddReferencedObject(SyntheticScreensData); }
+		virtual FString GetReferencerName() const override { return TEXT("UiScreenNavigationPerformanceTest"); }
+		//~ End FGCObject interface
+
+	private:
+		void IssueOperation();
+		int32 FindScreenToConstruct();
+		void CompleteOperation();
+		void SampleMemory();
+		void SampleLiveObjects();
+		void Finish();
+		void Report();
+
+		FAutomationTestBase& Test;
+		TWeakObjectPtr<UUiScreenManager> UiScreenManager;
+		TObjectPtr<UUiScreensData> SyntheticScreensData;
+		FGameplayTag PreviousScreenTag;
+
+		FRandomStream RandomStream;
+		TArray<FOperationSamples> Samples;
+
+		int32 NumOperations;
+		int32 IssuedOperations = 0;
+		EOperation PendingOperation = EOperation::Num;
+		double PendingOperationStartTime = 0.0;
+		int32 PendingOperationFrames = 0;
+		bool bStalled = false;
+		double RunStartTime = 0.0;
+		double RunTime = 0.0;
+		int32 SettleFramesLeft = INDEX_NONE;
+
+		int32 BaselineWidgets = 0;
+		int32 BaselineViewModels = 0;
+		int32 PeakWidgets = 0;
+		int32 PeakViewModels = 0;
+		uint64 BaselineUsedPhysical = 0;
+		uint64 PeakUsedPhysical = 0;
+		int32 RemainingWidgets = 0;
+		int32 RemainingViewModels = 0;
+		uint64 RemainingUsedPhysical = 0;
+	};
+
+	bool FNavigationRun::Start()
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("UiScreenNavigationOperations="), NumOperations);
+		NumOperations = FMath::Max(NumOperations, 1);
+
+		const UMainUiLayoutWidget* MainLayoutWidget = UiScreenManager->GetMainLayoutWidgetInfo().MainLayoutWidget;
+		TArray<FGameplayTag> LayerIds;
+		for (const FGameplayTag& LayerId : { Tag_UiLayerGame.GetTag(), Tag_UiLayerMenu.GetTag(), Tag_UiLayerModal.GetTag() })
+		{
+			if (MainLayoutWidget && MainLayoutWidget->GetLayerIndex(LayerId) != INDEX_NONE)
+			{
+				LayerIds.Add(LayerId);
+			}
+		}
+
+		if (LayerIds.IsEmpty())
+		{
+			Test.AddError(TEXT("Main layout widget has none of the UI.Layer.Game, UI.Layer.Menu and UI.Layer.Modal layers to navigate in"));
+			return false;
+		}
+
+		const TSoftClassPtr<UCommonActivatableWidget> ScreenClasses[] =
+		{
+			UUiScreenNavigationTestScreenA::StaticClass(),
+			UUiScreenNavigationTestScreenB::StaticClass(),
+			UUiScreenNavigationTestScreenC::StaticClass(),
+			UUiScreenNavigationTestScreenD::StaticClass()
+		};
+
+		// Native classes are always resident, so streaming doesn't show up in the per-operation cost
+		SyntheticScreensData = NewObject<UUiScreensData>(GetTransientPackage(), NAME_None, RF_Transient);
+		SyntheticScreensData->Screens.Reserve(NumScreens);
+		for (int32 Index = 0; Index < NumScreens; ++Index)
+		{
+			FUiScreenInfo& SyntheticScreen = SyntheticScreensData->Screens.AddDefaulted_GetRef();
+			SyntheticScreen.ScreenId = GetSyntheticScreenTag(Index);
+			SyntheticScreen.LayerId = LayerIds[Index % LayerIds.Num()];
+			SyntheticScreen.ScreenClass = ScreenClasses[(Index / LayerIds.Num()) % UE_ARRAY_COUNT(ScreenClasses)];
+			SyntheticScreen.ScreenViewModelClass = UUiScreenNavigationTestViewModel::StaticClass();
+		}
+
+		PreviousScreenTag = UiScreenManager->GetCurrentUiScreenData().ScreenId;
+		UiScreenManager->SetScreensDataOverride(SyntheticScreensData);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		BaselineWidgets = PeakWidgets = CountLiveObjects<UCommonActivatableWidget>();
+		BaselineViewModels = PeakViewModels = CountLiveObjects<UScreenViewModel>();
+		BaselineUsedPhysical = PeakUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+		Test.AddInfo(FString::Printf(TEXT("Running %d navigations over %d synthetic screens on %d layers"), NumOperations, NumScreens, LayerIds.Num()));
+
+		RunStartTime = FPlatformTime::Seconds();
+		return true;
+	}
+
+	bool FNavigationRun::Update()
+	{
+		if (!UiScreenManager.IsValid())
+		{
+			Test.AddError(TEXT("Screen manager was destroyed during the run"));
+			return true;
+		}
+
+		if (SettleFramesLeft != INDEX_NONE)
+		{
+			if (--SettleFramesLeft > 0)
+			{
+				return false;
+			}
+
+			RemainingWidgets = CountLiveObjects<UCommonActivatableWidget>();
+			RemainingViewModels = CountLiveObjects<UScreenViewModel>();
+			RemainingUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			Report();
+
+			if (PreviousScreenTag.IsValid())
+			{
+				UiScreenManager->ChangeUiScreen(FScreenInitialData(PreviousScreenTag, true));
+			}
+
+			return true;
+		}
+
+		if (PendingOperation != EOperation::Num)
+		{
+			++PendingOperationFrames;
+			if (UiScreenManager->IsNavigationIdle())
+			{
+				CompleteOperation();
+			}
+			else if (FPlatformTime::Seconds() - PendingOperationStartTime > OperationTimeoutSeconds)
+			{
+				Test.AddError(FString::Printf(TEXT("%s #%d didn't finish within %.0f s, stopping the run"), LexToString(PendingOperation), IssuedOperations,
+					OperationTimeoutSeconds));
+				bStalled = true;
+				Finish();
+				return false;
+			}
+		}
+
+		if (PendingOperation == EOperation::Num)
+		{
+			if (IssuedOperations < NumOperations)
+			{
+				IssueOperation();
+			}
+			else
+			{
+				Finish();
+			}
+		}
+
+		return false;
+	}
+
+	int32 FNavigationRun::FindScreenToConstruct()
+	{
+		UMainUiLayoutWidget* MainLayoutWidget = UiScreenManager->GetMainLayoutWidgetInfo().MainLayoutWidget;
+		const FGameplayTag CurrentScreenTag = UiScreenManager->GetCurrentUiScreenData().ScreenId;
+
+		const int32 FirstCandidate = RandomStream.RandRange(0, NumScreens - 1);
+		for (int32 Offset = 0; Offset < NumScreens; ++Offset)
+		{
+			const int32 Index = (FirstCandidate + Offset) % NumScreens;
+			const FUiScreenInfo& ScreenInfo = SyntheticScreensData->Screens[Index];
+			if (ScreenInfo.ScreenId == CurrentScreenTag)
+			{
+				continue;
+			}
+
+			const ULayerWidget* LayerWidget = MainLayoutWidget ? MainLayoutWidget->GetLayerForScreenInfo(ScreenInfo) : nullptr;
+			if (!LayerWidget || LayerWidget->FindSwitcherIndexForClass(ScreenInfo.ScreenClass.Get()) == INDEX_NONE)
+			{
+				return Index;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	void FNavigationRun::IssueOperation()
+	{
+		// Mostly forward navigation, with enough back and cleanup navigations to exercise the history and teardown
+		const int32 Roll = RandomStream.RandRange(0, 99);
+		const bool bHasHistory = !UiScreenManager->GetCurrentUiScreenData().PreviousScreens.IsEmpty();
+		EOperation Operation = Roll < 20 && bHasHistory ? EOperation::Back : Roll >= 90 ? EOperation::Cleanup : EOperation::Change;
+
+		int32 ScreenIndex = RandomStream.RandRange(0, NumScreens - 1);
+		if (Operation == EOperation::Change)
+		{
+			ScreenIndex = FindScreenToConstruct();
+			if (ScreenIndex == INDEX_NONE)
+			{
+				Operation = EOperation::Cleanup;
+				ScreenIndex = RandomStream.RandRange(0, NumScreens - 1);
+			}
+		}
+
+		PendingOperation = Operation;
+		PendingOperationFrames = 0;
+		PendingOperationStartTime = FPlatformTime::Seconds();
+		++IssuedOperations;
+
+		switch (Operation)
+		{
+		case EOperation::Back:
+			UiScreenManager->GoToThePreviousUiScreen();
+			break;
+		default:
+			UiScreenManager->ChangeUiScreen(FScreenInitialData(GetSyntheticScreenTag(ScreenIndex), Operation == EOperation::Cleanup));
+			break;
+		}
+
+		Samples[static_cast<int32>(Operation)].CallMs.Add((FPlatformTime::Seconds() - PendingOperationStartTime) * 1000.0);
+		SampleMemory();
+	}
+
+	void FNavigationRun::CompleteOperation()
+	{
+		FOperationSamples& OperationSamples = Samples[static_cast<int32>(PendingOperation)];
+		OperationSamples.CompletionMs.Add((FPlatformTime::Seconds() - PendingOperationStartTime) * 1000.0);
+		OperationSamples.CompletionFrames.Add(PendingOperationFrames);
+		PendingOperation = EOperation::Num;
+
+		SampleMemory();
+		if (IssuedOperations % LiveObjectSampleInterval == 0)
+		{
+			SampleLiveObjects();
+		}
+	}
+
+	void FNavigationRun::SampleMemory()
+	{
+		PeakUsedPhysical = FMath::Max(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	void FNavigationRun::SampleLiveObjects()
+	{
+		PeakWidgets = FMath::Max(PeakWidgets, CountLiveObjects<UCommonActivatableWidget>());
+		PeakViewModels = FMath::Max(PeakViewModels, CountLiveObjects<UScreenViewModel>());
+	}
+
+	void FNavigationRun::Finish()
+	{
+		RunTime = FPlatformTime::Seconds() - RunStartTime;
+		SampleMemory();
+		SampleLiveObjects();
+
+		// Tears down all synthetic screens and their view models synchronously
+		UiScreenManager->SetScreensDataOverride(nullptr);
+		SyntheticScreensData = nullptr;
+
+		if (GEngine)
+		{
+			GEngine->ForceGarbageCollection(true);
+		}
+
+		SettleFramesLeft = SettleFrames;
+	}
+
+	void FNavigationRun::Report()
+	{
+		constexpr double BytesPerMb = 1024.0 * 1024.0;
+		const int32 CompletedOperations = IssuedOperations - (bStalled ? 1 : 0);
+
+		Test.AddInfo(FString::Printf(TEXT("%d of %d navigations completed in %.2f s"), CompletedOperations, NumOperations, RunTime));
+
+		FString Csv = TEXT("Operation,Count,MeanCallMs,P95CallMs,MaxCallMs,MeanMs,P95Ms,MaxMs,MeanFrames\n");
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			const FOperationSamples& OperationSamples = Samples[Index];
+			if (OperationSamples.CompletionMs.IsEmpty())
+			{
+				continue;
+			}
+
+			double MeanFrames = 0.0;
+			for (const int32 Frames : OperationSamples.CompletionFrames)
+			{
+				MeanFrames += Frames;
+			}
+			MeanFrames /= OperationSamples.CompletionFrames.Num();
+
+			const TCHAR* OperationName = LexToString(static_cast<EOperation>(Index));
+			const double P95CallMs = GetPercentile(OperationSamples.CallMs, 0.95);
+			const double P95CompletionMs = GetPercentile(OperationSamples.CompletionMs, 0.95);
+			const double MaxCallMs = FMath::Max(OperationSamples.CallMs);
+			const double MaxMs = FMath::Max(OperationSamples.CompletionMs);
+			Test.AddInfo(FString::Printf(TEXT("%s: count %d, call mean %.3f ms, p95 %.3f ms, max %.3f ms, completion mean %.2f ms, p95 %.2f ms, max %.2f ms, %.1f frames"),
+				OperationName, OperationSamples.CompletionMs.Num(), GetMean(OperationSamples.CallMs), P95CallMs, MaxCallMs, GetMean(OperationSamples.CompletionMs),
+				P95CompletionMs, MaxMs, MeanFrames));
+
+			Csv += FString::Printf(TEXT("%s,%d,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.2f\n"), OperationName, OperationSamples.CompletionMs.Num(), GetMean(OperationSamples.CallMs),
+				P95CallMs, MaxCallMs, GetMean(OperationSamples.CompletionMs), P95CompletionMs, MaxMs, MeanFrames);
+		}
+
+		Test.AddInfo(FString::Printf(TEXT("Live screen widgets: %d before, peak %d, %d after teardown"), BaselineWidgets, PeakWidgets, RemainingWidgets));
+		Test.AddInfo(FString::Printf(TEXT("Live screen view models: %d before, peak %d, %d after teardown"), BaselineViewModels, PeakViewModels, RemainingViewModels));
+		Test.AddInfo(FString::Printf(TEXT("Used physical memory: %.1f MB before, peak %.1f MB, %+.1f MB after teardown"), BaselineUsedPhysical / BytesPerMb,
+			PeakUsedPhysical / BytesPerMb, (static_cast<double>(RemainingUsedPhysical) - static_cast<double>(BaselineUsedPhysical)) / BytesPerMb));
+
+		// Timings are only reported, they depend on the machine and its load too much to be asserted
+		Test.TestFalse(TEXT("Run stalled"), bStalled);
+
+		// Layer pools and keep-alive caches hold on to widget instances on purpose, view models have to be gone though
+		Test.TestTrue(FString::Printf(TEXT("No screen view models leaked (%d before, %d after teardown)"), BaselineViewModels, RemainingViewModels),
+			RemainingViewModels <= BaselineViewModels);
+
+		Csv += FString::Printf(TEXT("\nScreens,%d\nOperations,%d\nCompleted,%d\nRunSeconds,%.3f\n"), NumScreens, NumOperations, CompletedOperations, RunTime);
+		Csv += FString::Printf(TEXT("WidgetsBefore,%d\nWidgetsPeak,%d\nWidgetsAfter,%d\n"), BaselineWidgets, PeakWidgets, RemainingWidgets);
+		Csv += FString::Printf(TEXT("ViewModelsBefore,%d\nViewModelsPeak,%d\nViewModelsAfter,%d\n"), BaselineViewModels, PeakViewModels, RemainingViewModels);
+		Csv += FString::Printf(TEXT("UsedPhysicalBefore,%llu\nUsedPhysicalPeak,%llu\nUsedPhysicalAfter,%llu\n"), BaselineUsedPhysical, PeakUsedPhysical, RemainingUsedPhysical);
+
+		const FString CsvPath = FPaths::ProfilingDir() / TEXT("UiScreenNavigation") / FString::Printf(TEXT("NavigationPerformance-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			Test.AddInfo(FString::Printf(TEXT("Results written to %s"), *CsvPath));
+		}
+		else
+		{
+			Test.AddWarning(FString::Printf(TEXT("Failed to write results to %s"), *CsvPath));
+		}
+	}
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FUiScreenNavigationRunCommand, TSharedPtr<UiScreenNavigationPerformanceTest::FNavigationRun>, NavigationRun);
+
+bool FUiScreenNavigationRunCommand::Update()
+{
+	return NavigationRun->Update();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUiScreenNavigationPerformanceTest, "UiScreenFramework.Performance.Navigation",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUiScreenNavigationPerformanceTest::RunTest(const FString& Parameters)
+{
+	// Needs a running game with the screen manager of a local player, e.g. PIE or -game -ExecCmds="Automation RunTests UiScreenFramework.Performance"
+	UUiScreenManager* UiScreenManager = UiScreenNavigationPerformanceTest::FindScreenManager();
+	if (!UiScreenManager)
+	{
+		AddError(TEXT("Navigation performance test needs an initialized screen manager of a local player in a game or PIE world"));
+		return false;
+	}
+
+	const TSharedPtr<UiScreenNavigationPerformanceTest::FNavigationRun> NavigationRun = MakeShared<UiScreenNavigationPerformanceTest::FNavigationRun>(*this, *UiScreenManager);
+	if (!NavigationRun->Start())
+	{
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FUiScreenNavigationRunCommand(NavigationRun));
+	return true;
+}
+
+#endif
@@ -0,0 +1,40 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonActivatableWidget.h"
+#include "ViewModels/ScreenViewModel.h"
+#include "UiScreenNavigationTestScreens.generated.h"
+
+// Screens of the navigation performance test. Distinct classes, since a layer holds a single live widget per class.
+
+UCLASS(Hidden, NotBlueprintable)
+class UUiScreenNavigationTestScreenA : public UCommonActivatableWidget
+{
+	GENERATED_BODY()
+};
+
+UCLASS(Hidden, NotBlueprintable)
+class UUiScreenNavigationTestScreenB : public UCommonActivatableWidget
+{
+	GENERATED_BODY()
+};
+
+UCLASS(Hidden, NotBlueprintable)
+class UUiScreenNavigationTestScreenC : public UCommonActivatableWidget
+{
+	GENERATED_BODY()
+};
+
+UCLASS(Hidden, NotBlueprintable)
+class UUiScreenNavigationTestScreenD : public UCommonActivatableWidget
+{
+	GENERATED_BODY()
+};
+
+UCLASS(Hidden, NotBlueprintable)
+class UUiScreenNavigationTestViewModel : public UScreenViewModel
+{
+	GENERATED_BODY()
+};
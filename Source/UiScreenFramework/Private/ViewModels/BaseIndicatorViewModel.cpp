@@ -10,9 +10,14 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BaseIndicatorViewModel)
 DEFINE_LOG_CATEGORY(LogBaseIndicatorViewModel);
 
+void UBaseIndicatorViewModel::SetIndicatorConfig(const UIndicatorConfigData* InIndicatorConfig)
+{
+	IndicatorConfig = InIndicatorConfig;
+}
+
 void UBaseIndicatorViewModel::SetIndicatorCategory(const EIndicatorCategory InIndicatorCategory)
 {
-	IndicatorCategory = InIndicatorCategory;
+	IndicatorCategoryOverride = InIndicatorCategory;
 }
 
 void UBaseIndicatorViewModel::SetIndicatorVisibility(bool bInVisibility, EIndicatorVisibilityPriority InPriority)
@@ -36,7 +41,7 @@ void UBaseIndicatorViewModel::SetIndicatorVisibility(bool bInVisibility, EIndica
 
 void UBaseIndicatorViewModel::SetIndicatorClass(TSoftClassPtr<UUserWidget> InIndicatorWidgetClass)
 {
-	IndicatorWidgetClass = InIndicatorWidgetClass;
+	IndicatorWidgetClassOverride = InIndicatorWidgetClass;
 }
 
 UUserWidget* UBaseIndicatorViewModel::GetIndicatorWidget()
@@ -46,62 +51,62 @@ UUserWidget* UBaseIndicatorViewModel::GetIndicatorWidget()
 
 void UBaseIndicatorViewModel::SetProjectionMode(const EIndicatorProjectionMode InProjectionMode)
 {
-	ProjectionMode = InProjectionMode;
+	ProjectionModeOverride = InProjectionMode;
 }
 
 void UBaseIndicatorViewModel::SetHAlign(const EHorizontalAlignment InHAlignment)
 {
-	HAlignment = InHAlignment;
+	HAlignmentOverride = InHAlignment;
 }
 
 void UBaseIndicatorViewModel::SetVAlign(const EVerticalAlignment InVAlignment)
 {
-	VAlignment = InVAlignment;
+	VAlignmentOverride = InVAlignment;
 }
 
 void UBaseIndicatorViewModel::SetClampToScreen(const bool bValue)
 {
-	bClampToScreen = bValue;
+	bClampToScreenOverride = bValue;
 }
 
 void UBaseIndicatorViewModel::SetWorldPositionOffset(const FVector Offset)
 {
-	WorldPositionOffset = Offset;
+	WorldPositionOffsetOverride = Offset;
 }
 
 void UBaseIndicatorViewModel::SetScreenSpaceOffset(const FVector2D Offset)
 {
-	ScreenSpaceOffset = Offset;
+	ScreenSpaceOffsetOverride = Offset;
 }
 
 void UBaseIndicatorViewModel::SetBoundingBoxAnchor(const FVector InBoundingBoxAnchor)
 {
-	BoundingBoxAnchor = InBoundingBoxAnchor;
+	BoundingBoxAnchorOverride = InBoundingBoxAnchor;
 }
 
 void UBaseIndicatorViewModel::SetTransitionTime(const float InTransitionTime)
 {
-	TransitionTime = InTransitionTime;
+	TransitionTimeOverride = InTransitionTime;
 }
 
 void UBaseIndicatorViewModel::SetHasVisibilityRange(const bool bValue)
 {
-	bHasVisibilityRange = bValue;
+	bHasVisibilityRangeOverride = bValue;
 }
 
 void UBaseIndicatorViewModel::SetShouldUpdateDistance(const bool bValue)
 {
-	bUpdateDistance = bValue;
+	bUpdateDistanceOverride = bValue;
 }
 
 void UBaseIndicatorViewModel::SetVisibilityRangeOuter(const float InVisibilityRangeOuter)
 {
-	VisibilityRangeOuter = InVisibilityRangeOuter;
+	VisibilityRangeOuterOverride = InVisibilityRangeOuter;
 }
 
 void UBaseIndicatorViewModel::SetVisibilityRangeInner(const float InVisibilityRangeInner)
 {
-	VisibilityRangeInner = InVisibilityRangeInner;
+	VisibilityRangeInnerOverride = InVisibilityRangeInner;
 }
 
 void UBaseIndicatorViewModel::SetPriority(const int32 InPriority)
@@ -117,7 +122,7 @@ bool UBaseIndicatorViewModel::IsPlayerWithinRange() const
 	if (PlayerPawn && InActorAttachedTo)
 	{
 		const float Distance = FVector::Dist(PlayerController->GetPawn()->GetActorLocation(), InActorAttachedTo->GetActorLocation());
-		if (Distance > VisibilityRangeOuter)
+		if (Distance > GetVisibilityRangeOuter())
 		{
 			return false;
 		}
@@ -134,6 +139,86 @@ void UBaseIndicatorViewModel::Deinit()
 	Super::Deinit();
 }
 
+void UBaseIndicatorViewModel::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	MigrateDeprecatedConfig();
+#endif
+}
+
+#if WITH_EDITORONLY_DATA
+void UBaseIndicatorViewModel::MigrateDeprecatedConfig()
+{
+	const UIndicatorConfigData& Defaults = *GetDefault<UIndicatorConfigData>();
+	const bool bHasDeprecatedSettings = IndicatorCategory_DEPRECATED != Defaults.IndicatorCategory
+		|| !IndicatorWidgetClass_DEPRECATED.IsNull()
+		|| ProjectionMode_DEPRECATED != Defaults.ProjectionMode
+		|| HAlignment_DEPRECATED != Defaults.HAlignment
+		|| VAlignment_DEPRECATED != Defaults.VAlignment
+		|| BoundingBoxAnchor_DEPRECATED != Defaults.BoundingBoxAnchor
+		|| ScreenSpaceOffset_DEPRECATED != Defaults.ScreenSpaceOffset
+		|| WorldPositionOffset_DEPRECATED != Defaults.WorldPositionOffset
+		|| TransitionTime_DEPRECATED != Defaults.TransitionTime
+		|| bClampToScreen_DEPRECATED != Defaults.bClampToScreen
+		|| bUpdateDistance_DEPRECATED != Defaults.bUpdateDistance
+		|| bHasVisibilityRange_DEPRECATED != Defaults.bHasVisibilityRange
+		|| VisibilityRangeOuter_DEPRECATED != Defaults.VisibilityRangeOuter
+		|| VisibilityRangeInner_DEPRECATED != Defaults.VisibilityRangeInner;
+
+	if (!bHasDeprecatedSettings)
+	{
+		return;
+	}
+
+	if (IndicatorConfig)
+	{
+		UE_LOG(LogBaseIndicatorViewModel, Warning, TEXT("%hs Deprecated settings of %s are ignored, IndicatorConfig %s is already set"),
+			__FUNCTION__, *GetPathName(), *GetNameSafe(IndicatorConfig));
+	}
+	else
+	{
+		// Owned by the view model so it is saved with it, it can be replaced by a shared asset afterwards
+		UIndicatorConfigData* MigratedConfig = NewObject<UIndicatorConfigData>(this, TEXT("MigratedIndicatorConfig"), GetMaskedFlags(RF_PropagateToSubObjects));
+		MigratedConfig->IndicatorCategory = IndicatorCategory_DEPRECATED;
+		MigratedConfig->IndicatorWidgetClass = IndicatorWidgetClass_DEPRECATED;
+		MigratedConfig->ProjectionMode = ProjectionMode_DEPRECATED;
+		MigratedConfig->HAlignment = HAlignment_DEPRECATED;
+		MigratedConfig->VAlignment = VAlignment_DEPRECATED;
+		MigratedConfig->BoundingBoxAnchor = BoundingBoxAnchor_DEPRECATED;
+		MigratedConfig->ScreenSpaceOffset = ScreenSpaceOffset_DEPRECATED;
+		MigratedConfig->WorldPositionOffset = WorldPositionOffset_DEPRECATED;
+		MigratedConfig->TransitionTime = TransitionTime_DEPRECATED;
+		MigratedConfig->bClampToScreen = bClampToScreen_DEPRECATED;
+		MigratedConfig->bUpdateDistance = bUpdateDistance_DEPRECATED;
+		MigratedConfig->bHasVisibilityRange = bHasVisibilityRange_DEPRECATED;
+		MigratedConfig->VisibilityRangeOuter = VisibilityRangeOuter_DEPRECATED;
+		MigratedConfig->VisibilityRangeInner = VisibilityRangeInner_DEPRECATED;
+		IndicatorConfig = MigratedConfig;
+
+		UE_LOG(LogBaseIndicatorViewModel, Log, TEXT("%hs Migrated deprecated settings of %s into %s"), __FUNCTION__, *GetPathName(), *MigratedConfig->GetName());
+	}
+
+	// Reset so objects using this one as archetype do not migrate the same values again
+	const UBaseIndicatorViewModel* ClassDefaults = GetDefault<UBaseIndicatorViewModel>();
+	IndicatorCategory_DEPRECATED = ClassDefaults->IndicatorCategory_DEPRECATED;
+	IndicatorWidgetClass_DEPRECATED.Reset();
+	ProjectionMode_DEPRECATED = ClassDefaults->ProjectionMode_DEPRECATED;
+	HAlignment_DEPRECATED = ClassDefaults->HAlignment_DEPRECATED;
+	VAlignment_DEPRECATED = ClassDefaults->VAlignment_DEPRECATED;
+	BoundingBoxAnchor_DEPRECATED = ClassDefaults->BoundingBoxAnchor_DEPRECATED;
+	ScreenSpaceOffset_DEPRECATED = ClassDefaults->ScreenSpaceOffset_DEPRECATED;
+	WorldPositionOffset_DEPRECATED = ClassDefaults->WorldPositionOffset_DEPRECATED;
+	TransitionTime_DEPRECATED = ClassDefaults->TransitionTime_DEPRECATED;
+	bClampToScreen_DEPRECATED = ClassDefaults->bClampToScreen_DEPRECATED;
+	bUpdateDistance_DEPRECATED = ClassDefaults->bUpdateDistance_DEPRECATED;
+	bHasVisibilityRange_DEPRECATED = ClassDefaults->bHasVisibilityRange_DEPRECATED;
+	VisibilityRangeOuter_DEPRECATED = ClassDefaults->VisibilityRangeOuter_DEPRECATED;
+	VisibilityRangeInner_DEPRECATED = ClassDefaults->VisibilityRangeInner_DEPRECATED;
+}
+#endif
+
 float UBaseIndicatorViewModel::CalculateOuterDistanceFactor(const float Distance, const float OuterRange, float InnerRange)
 {
 	if (Distance > OuterRange)
@@ -155,6 +240,35 @@ float UBaseIndicatorViewModel::CalculateOuterDistanceFactor(const float Distance
 	return OutDistanceFactor;
 }
 
+int32 UBaseIndicatorViewModel::SelectLodIndex(const TArray<FIndicatorLodEntry>& InLodEntries, const int32 CurrentLodIndex, const float Distance, const float Hysteresis)
+{
+	int32 NewLodIndex = InLodEntries.IndexOfByPredicate([Distance](const FIndicatorLodEntry& LodEntry)
+	{
+		return Distance <= LodEntry.MaxDistance;
+	});
+
+	// Beyond the farthest band the indicator isn't displayed at all
+	if (NewLodIndex == INDEX_NONE)
+	{
+		NewLodIndex = InLodEntries.Num();
+	}
+
+	if (CurrentLodIndex == INDEX_NONE || CurrentLodIndex == NewLodIndex)
+	{
+		return NewLodIndex;
+	}
+
+	// Stay in the current band until the distance leaves it by more than the hysteresis, it prevents flickering on the band edges
+	const float BandMinDistance = InLodEntries.IsValidIndex(CurrentLodIndex - 1) ? InLodEntries[CurrentLodIndex - 1].MaxDistance : 0.f;
+	const float BandMaxDistance = InLodEntries.IsValidIndex(CurrentLodIndex) ? InLodEntries[CurrentLodIndex].MaxDistance : UE_BIG_NUMBER;
+	if (Distance > BandMinDistance - Hysteresis && Distance <= BandMaxDistance + Hysteresis)
+	{
+		return CurrentLodIndex;
+	}
+
+	return NewLodIndex;
+}
+
 float UBaseIndicatorViewModel::GetDistanceFactor() const
 {
 	const APlayerController* PlayerController = GeneralHelper::GetPlayerController(this);
@@ -167,7 +281,7 @@ float UBaseIndicatorViewModel::GetDistanceFactor() const
 
 	const float Distance = FVector::Dist(PlayerPawn->GetActorLocation(), InActorAttachedTo->GetActorLocation());
 
-	return CalculateOuterDistanceFactor(Distance, VisibilityRangeOuter, VisibilityRangeInner);
+	return CalculateOuterDistanceFactor(Distance, GetVisibilityRangeOuter(), GetVisibilityRangeInner());
 }
 
 void UBaseIndicatorViewModel::ResetActorAttachedTo()
@@ -2,6 +2,11 @@
 
 #include "ViewModels/ScreenViewModel.h"
 
+#include "Async/Future.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ScreenViewModel)
 
 void UScreenViewModel::Init()
@@ -14,6 +19,46 @@ void UScreenViewModel::Deinit()
 {
 	ensureAlways(bHasBeenInit);
 	bHasBeenInit = false;
+	bIsReady = false;
 
 	Super::Deinit();
 }
+
+TFuture<void> UScreenViewModel::InitAsync()
+{
+	return MakeFulfilledPromise<void>().GetFuture();
+}
+
+void UScreenViewModel::CompleteAsyncInit()
+{
+	check(IsInGameThread());
+
+	// Deinitialized while the asynchronous work was running
+	if (!bHasBeenInit || bIsReady)
+	{
+		return;
+	}
+
+	bIsReady = true;
+	CommitAsyncInit();
+}
+
+void UScreenViewModel::SaveSnapshot(TArray<uint8>& OutSnapshot)
+{
+	FMemoryWriter MemoryWriter(OutSnapshot, true);
+	FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, false);
+	Archive.ArIsSaveGame = true;
+
+	Serialize(Archive);
+}
+
+void UScreenViewModel::RestoreSnapshot(const TArray<uint8>& Snapshot)
+{
+	FMemoryReader MemoryReader(Snapshot, true);
+	FObjectAndNameAsStringProxyArchive Archive(MemoryReader, true);
+	Archive.ArIsSaveGame = true;
+
+	Serialize(Archive);
+
+	OnRestoredFromSnapshot();
+}
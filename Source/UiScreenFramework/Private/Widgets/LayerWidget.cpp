@@ -3,7 +3,13 @@
 #include "Widgets/LayerWidget.h"
 
 #include "CommonActivatableWidget.h"
+#include "Algo/Reverse.h"
+#include "Blueprint/WidgetTree.h"
+#include "Helpers/UiScreenManagerHelper.h"
+#include "Helpers/ViewModelHelper.h"
+#include "Logging/UiScreenFrameworkTrace.h"
 #include "Slate/SCommonAnimatedSwitcher.h"
+#include "Widgets/SInvalidationPanel.h"
 #include "Widgets/SOverlay.h"
 #include "Widgets/Layout/SSpacer.h"
 #include "TimerManager.h"
@@ -12,6 +18,10 @@
 
 DEFINE_LOG_CATEGORY(LogLayerWidget);
 
+TRACE_DECLARE_INT_COUNTER(UiLayerRetainedWidgetHits, TEXT("UiScreenFramework/Layer Retained Widget Hits"));
+TRACE_DECLARE_INT_COUNTER(UiLayerPoolHits, TEXT("UiScreenFramework/Layer Pool Hits"));
+TRACE_DECLARE_INT_COUNTER(UiLayerPoolMisses, TEXT("UiScreenFramework/Layer Pool Misses"));
+
 UCommonActivatableWidget* GetActivatableWidgetFromSlate(const TSharedPtr<SWidget>& SlateWidget)
 {
 	if (SlateWidget && SlateWidget != SNullWidget::NullWidget && ensure(SlateWidget->GetType().IsEqual(TEXT("SObjectWidget"))))
@@ -25,6 +35,41 @@ UCommonActivatableWidget* GetActivatableWidgetFromSlate(const TSharedPtr<SWidget
 	return nullptr;
 }
 
+namespace
+{
+	// Nested user widgets innermost first, so each one is built before the widget containing it
+	void GatherNestedUserWidgets(const UUserWidget& Widget, TArray<TWeakObjectPtr<UUserWidget>>& OutNestedWidgets)
+	{
+		if (!Widget.WidgetTree)
+		{
+			return;
+		}
+
+		Widget.WidgetTree->ForEachWidget([&OutNestedWidgets](UWidget* ChildWidget)
+		{
+			if (UUserWidget* ChildUserWidget = Cast<UUserWidget>(ChildWidget))
+			{
+				GatherNestedUserWidgets(*ChildUserWidget, OutNestedWidgets);
+				OutNestedWidgets.Add(ChildUserWidget);
+			}
+		});
+	}
+
+	// Rough cost of the Slate side of a single UMG widget, only used to budget the keep-alive cache
+	constexpr int64 EstimatedSlateBytesPerWidget = 1024;
+
+	int64 EstimateWidgetSizeBytes(UCommonActivatableWidget& Widget)
+	{
+		int32 NumWidgets = 1;
+		if (Widget.WidgetTree)
+		{
+			Widget.WidgetTree->ForEachWidget([&NumWidgets](UWidget*) { ++NumWidgets; });
+		}
+
+		return Widget.GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) + NumWidgets * EstimatedSlateBytesPerWidget;
+	}
+}
+
 ULayerWidget::ULayerWidget(const FObjectInitializer& Initializer)
 	: Super(Initializer)
 	  , GeneratedWidgetsPool(*this)
@@ -34,7 +79,12 @@ ULayerWidget::ULayerWidget(const FObjectInitializer& Initializer)
 
 UCommonActivatableWidget* ULayerWidget::GetActiveWidget() const
 {
-	return MySwitcher ? GetActivatableWidgetFromSlate(MySwitcher->GetActiveWidget()) : nullptr;
+	if (!MySwitcher || (PlaceholderWidget && MySwitcher->GetActiveWidget() == PlaceholderWidget))
+	{
+		return nullptr;
+	}
+
+	return GetActivatableWidgetFromSlate(MySwitcher->GetActiveWidget());
 }
 
 int32 ULayerWidget::GetNumWidgets() const
@@ -42,6 +92,62 @@ int32 ULayerWidget::GetNumWidgets() const
 	return WidgetList.Num();
 }
 
+TArray<UCommonActivatableWidget*> ULayerWidget::GetLiveWidgets() const
+{
+	TArray<UCommonActivatableWidget*> LiveWidgets;
+	LiveWidgets.Reserve(WidgetList.Num());
+	for (UCommonActivatableWidget* Widget : WidgetList)
+	{
+		if (Widget)
+		{
+			LiveWidgets.Add(Widget);
+		}
+	}
+	return LiveWidgets;
+}
+
+int32 ULayerWidget::FindSwitcherIndexForClass(const UClass* WidgetClass) const
+{
+	const int32* WidgetListIndex = WidgetListIndexByClass.Find(WidgetClass);
+
+	// The 0th slot of the switcher is always empty
+	return WidgetListIndex ? *WidgetListIndex + 1 : INDEX_NONE;
+}
+
+bool ULayerWidget::HasLiveWidgetOfClass(const UClass* WidgetClass) const
+{
+	return NumLiveWidgetsByClass.FindRef(WidgetClass) > 0;
+}
+
+bool ULayerWidget::IsTransitioning() const
+{
+	return MySwitcher && MySwitcher->IsTransitionPlaying();
+}
+
+void ULayerWidget::AddWidgetIncrementally(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	CancelIncrementalConstruction();
+
+	if (!ActivatableWidgetClass)
+	{
+		return;
+	}
+
+	// Retained instances have their Slate tree built already
+	if (KeepAliveCache.ContainsByPredicate([ActivatableWidgetClass](const FLayerKeepAliveEntry& Entry) { return Entry.Widget && Entry.Widget->GetClass() == ActivatableWidgetClass; })
+		|| PendingReleaseWidgets.ContainsByPredicate([ActivatableWidgetClass](const FLayerKeepAliveEntry& Entry) { return Entry.Widget && Entry.Widget->GetClass() == ActivatableWidgetClass; }))
+	{
+		AddWidget(ActivatableWidgetClass);
+		return;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs Constructing %s incrementally"), __FUNCTION__, *ActivatableWidgetClass->GetName());
+
+	IncrementalWidgetClass = ActivatableWidgetClass;
+	IncrementalConstructionPhase = EIncrementalConstructionPhase::CreateWidget;
+	IncrementalConstructionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ULayerWidget::ProcessIncrementalConstruction));
+}
+
 void ULayerWidget::RemoveWidget(UCommonActivatableWidget& WidgetToRemove)
 {
 	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs WidgetToRemove: %s"), __FUNCTION__, *WidgetToRemove.GetName());
@@ -69,28 +175,161 @@ void ULayerWidget::RemoveWidget(UCommonActivatableWidget& WidgetToRemove)
 		else
 		{
 			GeneratedWidgetsPool.Release(&WidgetToRemove, true);
-			WidgetList.Remove(&WidgetToRemove);
+			RemoveFromWidgetList(WidgetToRemove);
+		}
+	}
+}
+
+void ULayerWidget::ShowPlaceholder()
+{
+	if (!MySwitcher || PlaceholderWidget)
+	{
+		return;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs"), __FUNCTION__);
+
+	PlaceholderWidget = SNew(SSpacer);
+	MySwitcher->AddSlot()[PlaceholderWidget.ToSharedRef()];
+	SetSwitcherIndex(MySwitcher->GetNumWidgets() - 1);
+}
+
+void ULayerWidget::RemovePlaceholder()
+{
+	if (!MySwitcher || !PlaceholderWidget)
+	{
+		return;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs"), __FUNCTION__);
+
+	const int32 PlaceholderIndex = MySwitcher->GetWidgetIndex(PlaceholderWidget.ToSharedRef());
+	if (PlaceholderIndex > 0 && (IsTransitioning() || MySwitcher->GetActiveWidgetIndex() == PlaceholderIndex))
+	{
+		// The layer switched to an existing widget meanwhile, retargeting would override that switch
+		if (!bPlaceholderIsSwitcherTarget && IsTransitioning())
+		{
+			return;
+		}
+
+		// The widget below was only deactivated, not marked for removal, so it's reactivated once the switcher lands on it
+		// The placeholder slot is released in HandleActiveIndexChanged
+		RestoreDormantEntry(PlaceholderIndex - 1);
+		MySwitcher->TransitionToIndex(PlaceholderIndex - 1, IsTransitioning());
+		return;
+	}
+
+	MySwitcher->RemoveSlot(PlaceholderWidget.ToSharedRef());
+	PlaceholderWidget.Reset();
+}
+
+bool ULayerWidget::ReplacePlaceholder(UCommonActivatableWidget& AddedWidget)
+{
+	if (!MySwitcher || !PlaceholderWidget)
+	{
+		return false;
+	}
+
+	const int32 PlaceholderIndex = MySwitcher->GetWidgetIndex(PlaceholderWidget.ToSharedRef());
+	PlaceholderWidget.Reset();
+	if (PlaceholderIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs %s replaces the placeholder in slot %d"), __FUNCTION__, *AddedWidget.GetName(), PlaceholderIndex);
+
+	MySwitcher->GetChildSlot(PlaceholderIndex)->AttachWidget(AddedWidget.TakeWidget());
+
+	// An ongoing transition lands on the slot and activates the widget, otherwise it's done here
+	if (!IsTransitioning())
+	{
+		if (MySwitcher->GetActiveWidgetIndex() == PlaceholderIndex)
+		{
+			HandleActiveIndexChanged(PlaceholderIndex);
+		}
+		else
+		{
+			SetSwitcherIndex(PlaceholderIndex);
 		}
 	}
+
+	return true;
+}
+
+void ULayerWidget::SetSuspended(const bool bInSuspended)
+{
+	if (bSuspended == bInSuspended)
+	{
+		return;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs %s bSuspended: %d"), __FUNCTION__, *GetName(), bInSuspended);
+	UI_SCREEN_TRACE_EVENT(TEXT("UiLayer %s %s"), *GetName(), bInSuspended ? TEXT("suspended") : TEXT("resumed"));
+
+	if (bInSuspended)
+	{
+		VisibilityBeforeSuspension = GetVisibility();
+		SetVisibility(ESlateVisibility::Collapsed);
+		bSuspended = true;
+
+		for (const UCommonActivatableWidget* Widget : WidgetList)
+		{
+			if (IsValid(Widget))
+			{
+				ViewModelHelper::SuspendBindings(*Widget, SuspendedViews);
+			}
+		}
+	}
+	else
+	{
+		bSuspended = false;
+		ViewModelHelper::ResumeBindings(SuspendedViews);
+		SetVisibility(VisibilityBeforeSuspension);
+	}
+}
+
+void ULayerWidget::SetLayerVisibility(const ESlateVisibility InVisibility)
+{
+	if (bSuspended)
+	{
+		VisibilityBeforeSuspension = InVisibility;
+	}
+	else
+	{
+		SetVisibility(InVisibility);
+	}
 }
 
 void ULayerWidget::ClearWidgets()
 {
+	CancelIncrementalConstruction();
 	SetSwitcherIndex(0);
 }
 
 TSharedRef<SWidget> ULayerWidget::RebuildWidget()
 {
+	TSharedRef<SWidget> SwitcherContent = SAssignNew(MySwitcher, SCommonAnimatedSwitcher)
+		.TransitionCurveType(TransitionCurveType)
+		.TransitionDuration(TransitionDuration)
+		.TransitionType(TransitionType)
+		.TransitionFallbackStrategy(TransitionFallbackStrategy)
+		.OnActiveIndexChanged_UObject(this, &ULayerWidget::HandleActiveIndexChanged)
+		.OnIsTransitioningChanged_UObject(this, &ULayerWidget::HandleSwitcherIsTransitioningChanged);
+
+	if (bUseInvalidationPanel)
+	{
+		SwitcherContent = SAssignNew(MyInvalidationPanel, SInvalidationPanel)
+			.DebugName(GetName())
+			[
+				SwitcherContent
+			];
+	}
+
 	MyOverlay = SNew(SOverlay)
 		+ SOverlay::Slot()
 		[
-			SAssignNew(MySwitcher, SCommonAnimatedSwitcher)
-			.TransitionCurveType(TransitionCurveType)
-			.TransitionDuration(TransitionDuration)
-			.TransitionType(TransitionType)
-			.TransitionFallbackStrategy(TransitionFallbackStrategy)
-			.OnActiveIndexChanged_UObject(this, &ULayerWidget::HandleActiveIndexChanged)
-			.OnIsTransitioningChanged_UObject(this, &ULayerWidget::HandleSwitcherIsTransitioningChanged)
+			SwitcherContent
 		]
 		+ SOverlay::Slot()
 		[
@@ -111,10 +350,21 @@ void ULayerWidget::ReleaseSlateResources(bool bReleaseChildren)
 	MyOverlay.Reset();
 	MyInputGuard.Reset();
 	MySwitcher.Reset();
+	MyInvalidationPanel.Reset();
+	PlaceholderWidget.Reset();
+	DormantEntries.Reset();
+	ViewModelHelper::ResumeBindings(SuspendedViews);
+	bSuspended = false;
 	ReleasedWidgets.Empty();
 	WidgetList.Reset();
+	WidgetListIndexByClass.Reset();
+	NumLiveWidgetsByClass.Reset();
 
+	CancelIncrementalConstruction();
+	TrimKeepAliveCache(0);
+	FlushPendingWidgetReleases();
 	GeneratedWidgetsPool.ReleaseAll(true);
+	PooledWidgetKeys.Reset();
 }
 
 void ULayerWidget::OnWidgetRebuilt()
@@ -132,8 +382,17 @@ void ULayerWidget::SetSwitcherIndex(int32 TargetIndex, bool bInstantTransition /
 	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs TargetIndex: %d, bInstantTransition: %d, IsTransitionPlaying() %s, GetActiveWidgetIndex() %d"), __FUNCTION__, TargetIndex, bInstantTransition,
 		MySwitcher->IsTransitionPlaying() ? TEXT("true") : TEXT("false"), MySwitcher->GetActiveWidgetIndex());
 
+	// A widget still under construction would be pushed over the one switched to once complete
+	CancelIncrementalConstruction();
+
 	if (MySwitcher)
 	{
+		if (PlaceholderWidget)
+		{
+			// A placeholder that isn't the target anymore sits above it, so it's released once the switcher lands on the target
+			bPlaceholderIsSwitcherTarget = MySwitcher->GetWidgetIndex(PlaceholderWidget.ToSharedRef()) == TargetIndex;
+		}
+
 		if (DisplayedWidget && MySwitcher->GetActiveWidgetIndex() != TargetIndex)
 		{
 			DisplayedWidget->OnDeactivated().RemoveAll(this);
@@ -147,13 +406,17 @@ void ULayerWidget::SetSwitcherIndex(int32 TargetIndex, bool bInstantTransition /
 			}
 		}
 
+		RestoreDormantEntry(TargetIndex);
 		MySwitcher->TransitionToIndex(TargetIndex, MySwitcher->IsTransitionPlaying() ? true : bInstantTransition);
 	}
 }
 
 UCommonActivatableWidget* ULayerWidget::AddWidgetInternal(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass, TFunctionRef<void(UCommonActivatableWidget&)> InitFunc)
 {
-	if (UCommonActivatableWidget* WidgetInstance = GeneratedWidgetsPool.GetOrCreateInstance(ActivatableWidgetClass))
+	CancelIncrementalConstruction();
+
+	UCommonActivatableWidget* WidgetInstance = TakeOrCreateInstance(ActivatableWidgetClass);
+	if (WidgetInstance)
 	{
 		InitFunc(*WidgetInstance);
 		RegisterInstanceInternal(*WidgetInstance);
@@ -162,14 +425,230 @@ UCommonActivatableWidget* ULayerWidget::AddWidgetInternal(TSubclassOf<UCommonAct
 	return nullptr;
 }
 
+UCommonActivatableWidget* ULayerWidget::TakeOrCreateInstance(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	UCommonActivatableWidget* WidgetInstance = TakeRetainedWidget(KeepAliveCache, ActivatableWidgetClass);
+	if (!WidgetInstance)
+	{
+		// Reopened before its teardown finished, its Slate tree is still alive
+		WidgetInstance = TakeRetainedWidget(PendingReleaseWidgets, ActivatableWidgetClass);
+	}
+
+	if (WidgetInstance)
+	{
+		TRACE_COUNTER_INCREMENT(UiLayerRetainedWidgetHits);
+		CSV_CUSTOM_STAT(UiScreenFramework, LayerRetainedWidgetHits, 1, ECsvCustomStatOp::Accumulate);
+		return WidgetInstance;
+	}
+
+	return GetOrCreatePooledInstance(ActivatableWidgetClass);
+}
+
+UCommonActivatableWidget* ULayerWidget::GetOrCreatePooledInstance(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiLayer GetOrCreatePooledInstance"));
+
+	UCommonActivatableWidget* WidgetInstance = GeneratedWidgetsPool.GetOrCreateInstance(ActivatableWidgetClass);
+	if (!WidgetInstance)
+	{
+		return nullptr;
+	}
+
+	bool bAlreadyPooled = false;
+	PooledWidgetKeys.Add(TObjectKey<UCommonActivatableWidget>(WidgetInstance), &bAlreadyPooled);
+	if (bAlreadyPooled)
+	{
+		TRACE_COUNTER_INCREMENT(UiLayerPoolHits);
+		CSV_CUSTOM_STAT(UiScreenFramework, LayerPoolHits, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		TRACE_COUNTER_INCREMENT(UiLayerPoolMisses);
+		CSV_CUSTOM_STAT(UiScreenFramework, LayerPoolMisses, 1, ECsvCustomStatOp::Accumulate);
+		UI_SCREEN_TRACE_EVENT(TEXT("UiLayer %s pool miss %s"), *GetName(), *ActivatableWidgetClass->GetName());
+	}
+
+	return WidgetInstance;
+}
+
 void ULayerWidget::RegisterInstanceInternal(UCommonActivatableWidget& NewWidget)
 {
 	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs NewWidget: %s"), __FUNCTION__, *NewWidget.GetName());
 
 	if (ensure(!WidgetList.Contains(&NewWidget)))
 	{
-		WidgetList.Add(&NewWidget);
+		const int32 WidgetListIndex = WidgetList.Add(&NewWidget);
+		WidgetListIndexByClass.FindOrAdd(NewWidget.GetClass(), WidgetListIndex);
+		AddLiveWidgetOfClass(NewWidget.GetClass(), 1);
+
 		OnWidgetAddedToList(NewWidget);
+
+		// Bindings are initialized once the widget is added to the switcher, a hidden layer doesn't need them until it's resumed
+		if (bSuspended)
+		{
+			ViewModelHelper::SuspendBindings(NewWidget, SuspendedViews);
+		}
+
+		OnWidgetAddedEvent.Broadcast(NewWidget);
+	}
+}
+
+void ULayerWidget::RemoveFromWidgetList(UCommonActivatableWidget& Widget)
+{
+	const int32 WidgetListIndex = WidgetList.IndexOfByKey(&Widget);
+	if (WidgetListIndex != INDEX_NONE)
+	{
+		RemoveWidgetListEntry(WidgetListIndex);
+	}
+}
+
+void ULayerWidget::RemoveWidgetListEntry(const int32 WidgetListIndex)
+{
+	const UClass* RemovedClass = GetWidgetListEntryClass(WidgetListIndex);
+	if (WidgetList[WidgetListIndex])
+	{
+		AddLiveWidgetOfClass(RemovedClass, -1);
+	}
+
+	// The next entry of the same class becomes the first one, it's looked up before the removal while the switcher slots still match the list
+	int32 NextIndexOfClass = INDEX_NONE;
+	const int32* FirstIndexOfClass = RemovedClass ? WidgetListIndexByClass.Find(RemovedClass) : nullptr;
+	if (FirstIndexOfClass && *FirstIndexOfClass == WidgetListIndex)
+	{
+		for (int32 Index = WidgetListIndex + 1; Index < WidgetList.Num(); ++Index)
+		{
+			if (GetWidgetListEntryClass(Index) == RemovedClass)
+			{
+				NextIndexOfClass = Index;
+				break;
+			}
+		}
+
+		if (NextIndexOfClass == INDEX_NONE)
+		{
+			WidgetListIndexByClass.Remove(RemovedClass);
+		}
+	}
+
+	WidgetList.RemoveAt(WidgetListIndex);
+
+	for (TPair<TObjectKey<UClass>, int32>& ClassIndex : WidgetListIndexByClass)
+	{
+		if (ClassIndex.Value == WidgetListIndex)
+		{
+			ClassIndex.Value = NextIndexOfClass - 1;
+		}
+		else if (ClassIndex.Value > WidgetListIndex)
+		{
+			--ClassIndex.Value;
+		}
+	}
+}
+
+const UClass* ULayerWidget::GetWidgetListEntryClass(const int32 WidgetListIndex) const
+{
+	if (const UCommonActivatableWidget* Widget = WidgetList[WidgetListIndex])
+	{
+		return Widget->GetClass();
+	}
+
+	// Dormant entries are switched to like live ones, they're restored on the way
+	const int32 DormantEntryIndex = MySwitcher ? FindDormantEntryIndex(MySwitcher->GetWidget(WidgetListIndex + 1)) : INDEX_NONE;
+	return DormantEntryIndex != INDEX_NONE ? DormantEntries[DormantEntryIndex].WidgetClass.Get() : nullptr;
+}
+
+void ULayerWidget::AddLiveWidgetOfClass(const UClass* WidgetClass, const int32 Delta)
+{
+	int32& NumLiveWidgets = NumLiveWidgetsByClass.FindOrAdd(WidgetClass);
+	NumLiveWidgets += Delta;
+	if (NumLiveWidgets <= 0)
+	{
+		NumLiveWidgetsByClass.Remove(WidgetClass);
+	}
+}
+
+int32 ULayerWidget::FindDormantEntryIndex(const TSharedPtr<SWidget>& SlateWidget) const
+{
+	if (!SlateWidget)
+	{
+		return INDEX_NONE;
+	}
+
+	return DormantEntries.IndexOfByPredicate([&SlateWidget](const FLayerDormantEntry& Entry) { return Entry.StandInWidget == SlateWidget; });
+}
+
+bool ULayerWidget::IsEntryDormant(const int32 SlotIndex) const
+{
+	return MySwitcher && FindDormantEntryIndex(MySwitcher->GetWidget(SlotIndex)) != INDEX_NONE;
+}
+
+bool ULayerWidget::MakeEntryDormant(const int32 SlotIndex)
+{
+	if (!MySwitcher || SlotIndex <= 0 || IsEntryDormant(SlotIndex))
+	{
+		return false;
+	}
+
+	const TSharedPtr<SWidget> SlateWidget = MySwitcher->GetWidget(SlotIndex);
+	if (!SlateWidget || SlateWidget == PlaceholderWidget)
+	{
+		return false;
+	}
+
+	UCommonActivatableWidget* ActivatableWidget = GetActivatableWidgetFromSlate(SlateWidget);
+	const int32 WidgetListIndex = WidgetList.IndexOfByKey(ActivatableWidget);
+	if (!ActivatableWidget || ActivatableWidget == DisplayedWidget || ActivatableWidget->IsActivated() || WidgetListIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs %s in slot %d goes dormant"), __FUNCTION__, *ActivatableWidget->GetName(), SlotIndex);
+	UI_SCREEN_TRACE_EVENT(TEXT("UiLayer %s dormant %s"), *GetName(), *ActivatableWidget->GetClass()->GetName());
+
+	FLayerDormantEntry& DormantEntry = DormantEntries.AddDefaulted_GetRef();
+	DormantEntry.WidgetClass = ActivatableWidget->GetClass();
+	DormantEntry.StandInWidget = SNew(SSpacer);
+	MySwitcher->GetChildSlot(SlotIndex)->AttachWidget(DormantEntry.StandInWidget.ToSharedRef());
+
+	// The entry keeps its place in the widget list, so the following widgets keep their indices
+	WidgetList[WidgetListIndex] = nullptr;
+	AddLiveWidgetOfClass(ActivatableWidget->GetClass(), -1);
+
+	RetainOrReleaseWidget(*ActivatableWidget, SlateWidget.ToSharedRef(), true);
+	return true;
+}
+
+void ULayerWidget::RestoreDormantEntry(const int32 SlotIndex)
+{
+	if (DormantEntries.IsEmpty() || !MySwitcher)
+	{
+		return;
+	}
+
+	const int32 DormantEntryIndex = FindDormantEntryIndex(MySwitcher->GetWidget(SlotIndex));
+	if (DormantEntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TSubclassOf<UCommonActivatableWidget> WidgetClass = DormantEntries[DormantEntryIndex].WidgetClass;
+	UCommonActivatableWidget* WidgetInstance = TakeOrCreateInstance(WidgetClass);
+	if (!WidgetInstance)
+	{
+		UE_LOG(LogLayerWidget, Warning, TEXT("%hs Cannot restore the dormant entry in slot %d of %s"), __FUNCTION__, SlotIndex, *GetName());
+		return;
+	}
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs %s restored in slot %d"), __FUNCTION__, *WidgetInstance->GetName(), SlotIndex);
+	UI_SCREEN_TRACE_EVENT(TEXT("UiLayer %s restored %s"), *GetName(), *WidgetClass->GetName());
+
+	DormantEntries.RemoveAt(DormantEntryIndex);
+	MySwitcher->GetChildSlot(SlotIndex)->AttachWidget(WidgetInstance->TakeWidget());
+
+	if (WidgetList.IsValidIndex(SlotIndex - 1) && !WidgetList[SlotIndex - 1])
+	{
+		WidgetList[SlotIndex - 1] = WidgetInstance;
+		AddLiveWidgetOfClass(WidgetClass, 1);
 	}
 }
 
@@ -177,6 +656,21 @@ void ULayerWidget::HandleSwitcherIsTransitioningChanged(bool bIsTransitioning)
 {
 	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs bIsTransitioning: %d"), __FUNCTION__, bIsTransitioning);
 
+	if (bIsTransitioning)
+	{
+		UI_SCREEN_TRACE_BEGIN_REGION(TEXT("UiLayer Transition %s"), *GetName());
+	}
+	else
+	{
+		UI_SCREEN_TRACE_END_REGION(TEXT("UiLayer Transition %s"), *GetName());
+	}
+
+	// Transitions animate the content every frame, caching it would only add overhead
+	if (MyInvalidationPanel)
+	{
+		MyInvalidationPanel->SetCanCache(!bIsTransitioning);
+	}
+
 	// While the switcher is transitioning, put up the guard to intercept all input
 	MyInputGuard->SetVisibility(bIsTransitioning ? EVisibility::Visible : EVisibility::Collapsed);
 	OnTransitioningChanged.Broadcast(this, bIsTransitioning);
@@ -190,19 +684,43 @@ void ULayerWidget::HandleActiveWidgetDeactivated(UCommonActivatableWidget* Deact
 	// We'll clean up this slot once the switcher index actually changes
 	if (ensure(DeactivatedWidget == DisplayedWidget) && MySwitcher && MySwitcher->GetActiveWidgetIndex() > 0)
 	{
+		CancelIncrementalConstruction();
+
 		DisplayedWidget->OnDeactivated().RemoveAll(this);
+		RestoreDormantEntry(MySwitcher->GetActiveWidgetIndex() - 1);
 		MySwitcher->TransitionToIndex(MySwitcher->GetActiveWidgetIndex() - 1);
 	}
 }
 
 void ULayerWidget::ReleaseWidget(const TSharedRef<SWidget>& WidgetToRelease)
 {
-	if (UCommonActivatableWidget* ActivatableWidget = GetActivatableWidgetFromSlate(WidgetToRelease))
+	if (WidgetToRelease == PlaceholderWidget)
+	{
+		MySwitcher->RemoveSlot(WidgetToRelease);
+		PlaceholderWidget.Reset();
+		return;
+	}
+
+	const int32 DormantEntryIndex = FindDormantEntryIndex(WidgetToRelease);
+	if (DormantEntryIndex != INDEX_NONE)
+	{
+		UE_LOG(LogLayerWidget, Verbose, TEXT("%hs Releasing dormant entry of %s"), __FUNCTION__, *GetNameSafe(DormantEntries[DormantEntryIndex].WidgetClass));
+
+		// Its widget was released when it went dormant, only its place in the widget list is left
+		const int32 WidgetListIndex = MySwitcher->GetWidgetIndex(WidgetToRelease) - 1;
+		if (WidgetList.IsValidIndex(WidgetListIndex) && !WidgetList[WidgetListIndex])
+		{
+			RemoveWidgetListEntry(WidgetListIndex);
+		}
+
+		DormantEntries.RemoveAt(DormantEntryIndex);
+	}
+	else if (UCommonActivatableWidget* ActivatableWidget = GetActivatableWidgetFromSlate(WidgetToRelease))
 	{
 		UE_LOG(LogLayerWidget, Verbose, TEXT("%hs WidgetToRelease: %s"), __FUNCTION__, *ActivatableWidget->GetName());
 
-		GeneratedWidgetsPool.Release(ActivatableWidget, true);
-		WidgetList.Remove(ActivatableWidget);
+		RetainOrReleaseWidget(*ActivatableWidget, WidgetToRelease);
+		RemoveFromWidgetList(*ActivatableWidget);
 	}
 	else
 	{
@@ -228,6 +746,238 @@ void ULayerWidget::ReleaseWidget(const TSharedRef<SWidget>& WidgetToRelease)
 	}
 }
 
+void ULayerWidget::RetainOrReleaseWidget(UCommonActivatableWidget& ActivatableWidget, const TSharedRef<SWidget>& SlateWidget, const bool bSuspendBindings /*= false*/)
+{
+	FLayerKeepAliveEntry KeepAliveEntry;
+	KeepAliveEntry.Widget = &ActivatableWidget;
+	KeepAliveEntry.SlateWidget = SlateWidget;
+	KeepAliveEntry.PreviousVisibility = ActivatableWidget.GetVisibility();
+
+	if (bSuspendBindings)
+	{
+		ViewModelHelper::SuspendBindings(ActivatableWidget, KeepAliveEntry.SuspendedViews);
+	}
+
+	if (KeepAliveCacheSize <= 0)
+	{
+		QueueWidgetRelease(MoveTemp(KeepAliveEntry));
+		return;
+	}
+
+	KeepAliveEntry.EstimatedSizeBytes = EstimateWidgetSizeBytes(ActivatableWidget);
+
+	ActivatableWidget.SetVisibility(ESlateVisibility::Collapsed);
+	KeepAliveCache.Insert(MoveTemp(KeepAliveEntry), 0);
+
+	TrimKeepAliveCache(KeepAliveCacheSize);
+}
+
+UCommonActivatableWidget* ULayerWidget::TakeRetainedWidget(TArray<FLayerKeepAliveEntry>& RetainedWidgets, TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	const int32 EntryIndex = RetainedWidgets.IndexOfByPredicate([ActivatableWidgetClass](const FLayerKeepAliveEntry& Entry)
+	{
+		return Entry.Widget && Entry.Widget->GetClass() == ActivatableWidgetClass;
+	});
+
+	if (EntryIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	UCommonActivatableWidget* CachedWidget = RetainedWidgets[EntryIndex].Widget;
+	CachedWidget->SetVisibility(RetainedWidgets[EntryIndex].PreviousVisibility);
+	ViewModelHelper::ResumeBindings(RetainedWidgets[EntryIndex].SuspendedViews);
+	RetainedWidgets.RemoveAt(EntryIndex);
+
+	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs Reusing retained widget %s"), __FUNCTION__, *CachedWidget->GetName());
+	return CachedWidget;
+}
+
+void ULayerWidget::TrimKeepAliveCache(const int32 MaxEntries)
+{
+	const int64 MemoryBudgetBytes = static_cast<int64>(KeepAliveMemoryBudgetKB) * 1024;
+
+	int64 TotalSizeBytes = 0;
+	for (const FLayerKeepAliveEntry& Entry : KeepAliveCache)
+	{
+		TotalSizeBytes += Entry.EstimatedSizeBytes;
+	}
+
+	while (!KeepAliveCache.IsEmpty() && (KeepAliveCache.Num() > MaxEntries || TotalSizeBytes > MemoryBudgetBytes))
+	{
+		FLayerKeepAliveEntry EvictedEntry = KeepAliveCache.Pop();
+		TotalSizeBytes -= EvictedEntry.EstimatedSizeBytes;
+		QueueWidgetRelease(MoveTemp(EvictedEntry));
+	}
+}
+
+void ULayerWidget::QueueWidgetRelease(FLayerKeepAliveEntry&& Entry)
+{
+	PendingReleaseWidgets.Add(MoveTemp(Entry));
+
+	if (!PendingReleaseTickerHandle.IsValid())
+	{
+		PendingReleaseTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ULayerWidget::ProcessPendingWidgetReleases));
+	}
+}
+
+void ULayerWidget::ReleaseRetainedWidget(FLayerKeepAliveEntry&& Entry)
+{
+	// Slate tree has to be dropped before the pool releases the widget's Slate resources
+	Entry.SlateWidget.Reset();
+	if (UCommonActivatableWidget* ReleasedWidget = Entry.Widget)
+	{
+		UE_LOG(LogLayerWidget, Verbose, TEXT("%hs Releasing retained widget %s"), __FUNCTION__, *ReleasedWidget->GetName());
+
+		ReleasedWidget->SetVisibility(Entry.PreviousVisibility);
+		GeneratedWidgetsPool.Release(ReleasedWidget, true);
+	}
+}
+
+bool ULayerWidget::ProcessPendingWidgetReleases(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULayerWidget_ProcessPendingWidgetReleases);
+
+	// Destroying Slate trees during the transition would hitch it
+	if (IsTransitioning())
+	{
+		return true;
+	}
+
+	const double BudgetSeconds = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetDeferredTeardownBudgetSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	while (!PendingReleaseWidgets.IsEmpty())
+	{
+		ReleaseRetainedWidget(PendingReleaseWidgets.Pop());
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (PendingReleaseWidgets.IsEmpty())
+	{
+		PendingReleaseTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void ULayerWidget::FlushPendingWidgetReleases()
+{
+	if (PendingReleaseTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingReleaseTickerHandle);
+		PendingReleaseTickerHandle.Reset();
+	}
+
+	while (!PendingReleaseWidgets.IsEmpty())
+	{
+		ReleaseRetainedWidget(PendingReleaseWidgets.Pop());
+	}
+}
+
+void ULayerWidget::AdvanceIncrementalConstruction()
+{
+	switch (IncrementalConstructionPhase)
+	{
+	case EIncrementalConstructionPhase::CreateWidget:
+		// Creating the widget duplicates its whole widget tree at once, it's the only step that can't be split
+		IncrementalWidget = GetOrCreatePooledInstance(IncrementalWidgetClass);
+		if (IncrementalWidget)
+		{
+			// Reversed so the steps pop the innermost widget first
+			GatherNestedUserWidgets(*IncrementalWidget, IncrementalNestedWidgets);
+			Algo::Reverse(IncrementalNestedWidgets);
+		}
+		IncrementalConstructionPhase = IncrementalWidget ? EIncrementalConstructionPhase::BuildNestedSlate : EIncrementalConstructionPhase::None;
+		break;
+
+	case EIncrementalConstructionPhase::BuildNestedSlate:
+		// One nested widget per step, its Slate tree is cached and reused when the widget containing it is built
+		if (!IncrementalNestedWidgets.IsEmpty())
+		{
+			if (UUserWidget* NestedWidget = IncrementalNestedWidgets.Pop().Get())
+			{
+				NestedWidget->TakeWidget();
+			}
+		}
+
+		if (IncrementalNestedWidgets.IsEmpty())
+		{
+			IncrementalConstructionPhase = EIncrementalConstructionPhase::BuildSlate;
+		}
+		break;
+
+	case EIncrementalConstructionPhase::BuildSlate:
+		// Builds the Slate tree and constructs the widget, which initializes its view model bindings
+		IncrementalWidget->TakeWidget();
+		IncrementalConstructionPhase = EIncrementalConstructionPhase::Prepass;
+		break;
+
+	case EIncrementalConstructionPhase::Prepass:
+		{
+			const float LayoutScale = GetCachedGeometry().GetAccumulatedLayoutTransform().GetScale();
+			IncrementalWidget->TakeWidget()->SlatePrepass(LayoutScale > 0.f ? LayoutScale : 1.f);
+
+			UCommonActivatableWidget* ConstructedWidget = IncrementalWidget;
+			IncrementalWidget = nullptr;
+			IncrementalWidgetClass = nullptr;
+			IncrementalNestedWidgets.Reset();
+			IncrementalConstructionPhase = EIncrementalConstructionPhase::None;
+
+			UE_LOG(LogLayerWidget, Verbose, TEXT("%hs %s constructed"), __FUNCTION__, *ConstructedWidget->GetName());
+			RegisterInstanceInternal(*ConstructedWidget);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool ULayerWidget::ProcessIncrementalConstruction(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULayerWidget_ProcessIncrementalConstruction);
+
+	const double BudgetSeconds = UiScreenManagerHelper::GetUiScreenFrameworkSettings().GetIncrementalConstructionBudgetSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	do
+	{
+		AdvanceIncrementalConstruction();
+	}
+	while (IsConstructingWidget() && FPlatformTime::Seconds() - StartTime < BudgetSeconds);
+
+	if (!IsConstructingWidget())
+	{
+		IncrementalConstructionTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void ULayerWidget::CancelIncrementalConstruction()
+{
+	if (IncrementalConstructionTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(IncrementalConstructionTickerHandle);
+		IncrementalConstructionTickerHandle.Reset();
+	}
+
+	if (IncrementalWidget)
+	{
+		UE_LOG(LogLayerWidget, Verbose, TEXT("%hs Construction of %s cancelled"), __FUNCTION__, *IncrementalWidget->GetName());
+		GeneratedWidgetsPool.Release(IncrementalWidget, true);
+	}
+
+	IncrementalWidget = nullptr;
+	IncrementalWidgetClass = nullptr;
+	IncrementalNestedWidgets.Reset();
+	IncrementalConstructionPhase = EIncrementalConstructionPhase::None;
+}
+
 void ULayerWidget::HandleActiveIndexChanged(int32 ActiveWidgetIndex)
 {
 	UE_LOG(LogLayerWidget, Verbose, TEXT("%hs ActiveWidgetIndex: %d"), __FUNCTION__, ActiveWidgetIndex);
@@ -256,16 +1006,31 @@ void ULayerWidget::HandleActiveIndexChanged(int32 ActiveWidgetIndex)
 
 	bRemoveDisplayedWidgetPostTransition = false;
 
+	// The next widget is still loading, keep the layer as it is until it replaces the placeholder
+	if (PlaceholderWidget && MySwitcher->GetActiveWidget() == PlaceholderWidget)
+	{
+		DisplayedWidget = nullptr;
+		return;
+	}
+
+	// Transitions restore dormant entries before they start, this only covers the switcher falling back to one on its own
+	RestoreDormantEntry(ActiveWidgetIndex);
+
 	// Activate the widget that's now being displayed
 	DisplayedWidget = GetActivatableWidgetFromSlate(MySwitcher->GetActiveWidget());
 	if (DisplayedWidget)
 	{
-		SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+		SetLayerVisibility(ESlateVisibility::SelfHitTestInvisible);
 
 		DisplayedWidget->OnDeactivated().AddUObject(this, &ULayerWidget::HandleActiveWidgetDeactivated, ToRawPtr(DisplayedWidget));
 		DisplayedWidget->ActivateWidget();
 
-		if (UWorld* MyWorld = GetWorld())
+		if (MyInvalidationPanel)
+		{
+			// Only the cached content of this layer is stale, the rest of the UI doesn't need to be laid out again
+			MyInvalidationPanel->InvalidateRootLayout();
+		}
+		else if (UWorld* MyWorld = GetWorld())
 		{
 			FTimerManager& TimerManager = MyWorld->GetTimerManager();
 			TimerManager.SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]() { InvalidateLayoutAndVolatility(); }));
@@ -273,10 +1038,15 @@ void ULayerWidget::HandleActiveIndexChanged(int32 ActiveWidgetIndex)
 	}
 	else
 	{
-		SetVisibility(ESlateVisibility::Collapsed);
+		SetLayerVisibility(ESlateVisibility::Collapsed);
 	}
 
 	OnDisplayedWidgetChanged().Broadcast(DisplayedWidget);
+
+	if (DisplayedWidget)
+	{
+		OnActiveIndexChanged(ActiveWidgetIndex);
+	}
 }
 
 void ULayerWidget::SetTransitionDuration(float Duration)
@@ -329,10 +1099,34 @@ void ULayerWidgetStack::SynchronizeProperties()
 
 void ULayerWidgetStack::OnWidgetAddedToList(UCommonActivatableWidget& AddedWidget)
 {
-	if (MySwitcher)
+	if (MySwitcher && !ReplacePlaceholder(AddedWidget))
 	{
 		MySwitcher->AddSlot()[AddedWidget.TakeWidget()];
 
 		SetSwitcherIndex(MySwitcher->GetNumWidgets() - 1);
 	}
 }
+
+void ULayerWidgetStack::OnActiveIndexChanged(int32 ActiveWidgetIndex)
+{
+	if (MaxLiveStackEntries <= 0)
+	{
+		return;
+	}
+
+	// Slots above the active one are released already, the root content in slot 0 always stays live
+	int32 NumLiveEntries = 0;
+	for (int32 SlotIndex = 1; SlotIndex <= ActiveWidgetIndex; ++SlotIndex)
+	{
+		NumLiveEntries += IsEntryDormant(SlotIndex) ? 0 : 1;
+	}
+
+	// The deepest entries are the least likely to be popped back to
+	for (int32 SlotIndex = 1; SlotIndex < ActiveWidgetIndex && NumLiveEntries > MaxLiveStackEntries; ++SlotIndex)
+	{
+		if (MakeEntryDormant(SlotIndex))
+		{
+			--NumLiveEntries;
+		}
+	}
+}
@@ -11,20 +11,14 @@
 
 ULayerWidget* UMainUiLayoutWidget::GetLayerForScreenInfo(const FUiScreenInfo& UiScreenInfo)
 {
-	FGameplayTag LayerId = UiScreenInfo.LayerId;
-	FLayerInfo* TargetLayerInfo = Layers.FindByPredicate(
-		[LayerId](const FLayerInfo& Info)
-		{
-			return Info.LayerId == LayerId;
-		});
-
-	if (!TargetLayerInfo)
+	const int32 LayerIndex = GetLayerIndex(UiScreenInfo.LayerId);
+	if (LayerIndex == INDEX_NONE)
 	{
 		UE_LOG(LogUiScreenFramework, Error, TEXT("%hs: Cannot find layer info for layer %s."), __FUNCTION__, *UiScreenInfo.LayerId.ToString());
 		return nullptr;
 	}
 
-	ULayerWidget* FoundLayer = TargetLayerInfo->LayerWidget;
+	ULayerWidget* FoundLayer = Layers[LayerIndex].LayerWidget;
 
 	if (!IsValid(FoundLayer))
 	{
@@ -35,6 +29,47 @@ ULayerWidget* UMainUiLayoutWidget::GetLayerForScreenInfo(const FUiScreenInfo& Ui
 	return FoundLayer;
 }
 
+int32 UMainUiLayoutWidget::GetLayerIndex(const FGameplayTag LayerId) const
+{
+	const int32* LayerIndex = LayerIndexById.Find(LayerId);
+	return LayerIndex ? *LayerIndex : INDEX_NONE;
+}
+
+bool UMainUiLayoutWidget::IsAnyLayerTransitioning() const
+{
+	return Layers.ContainsByPredicate([](const FLayerInfo& Info)
+	{
+		return IsValid(Info.LayerWidget) && Info.LayerWidget->IsTransitioning();
+	});
+}
+
+bool UMainUiLayoutWidget::IsAnyLayerConstructing() const
+{
+	return Layers.ContainsByPredicate([](const FLayerInfo& Info)
+	{
+		return IsValid(Info.LayerWidget) && Info.LayerWidget->IsConstructingWidget();
+	});
+}
+
+bool UMainUiLayoutWidget::HasLiveWidgetOfClass(const UClass* WidgetClass) const
+{
+	return Layers.ContainsByPredicate([WidgetClass](const FLayerInfo& Info)
+	{
+		return IsValid(Info.LayerWidget) && Info.LayerWidget->HasLiveWidgetOfClass(WidgetClass);
+	});
+}
+
+void UMainUiLayoutWidget::ClearAllLayers()
+{
+	for (const FLayerInfo& Layer : Layers)
+	{
+		if (IsValid(Layer.LayerWidget))
+		{
+			Layer.LayerWidget->ClearWidgets();
+		}
+	}
+}
+
 bool UMainUiLayoutWidget::TrySwitchToExistingScreenInLayer(const FUiScreenInfo& UiScreenInfo)
 {
 	ULayerWidget* CurrentLayer = GetLayerForScreenInfo(UiScreenInfo);
@@ -43,42 +78,62 @@ bool UMainUiLayoutWidget::TrySwitchToExistingScreenInLayer(const FUiScreenInfo&
 		return false;
 	}
 
-	TArray<UCommonActivatableWidget*> ActiveWidgetList = CurrentLayer->GetWidgetList();
-	FSoftObjectPath StreamingObjectPath = UiScreenInfo.ScreenClass.ToSoftObjectPath();
-	const int32 FoundIndex = ActiveWidgetList.IndexOfByPredicate([StreamingObjectPath](UCommonActivatableWidget* Widget)
+	// A class that isn't loaded can't have an instance in the layer
+	const UClass* ScreenClass = UiScreenInfo.ScreenClass.Get();
+	if (!ScreenClass)
 	{
-		if (IsValid(Widget))
-		{
-			const FSoftObjectPath WidgetClassPath = Widget->GetClass()->GetPathName();
-
-			return WidgetClassPath == StreamingObjectPath;
-		}
-
 		return false;
-	});
+	}
 
-	if (ActiveWidgetList.IsValidIndex(FoundIndex))
+	const int32 FoundSwitcherIndex = CurrentLayer->FindSwitcherIndexForClass(ScreenClass);
+	if (FoundSwitcherIndex != INDEX_NONE)
 	{
-		CurrentLayer->SetSwitcherIndex(FoundIndex + 1);
+		CurrentLayer->SetSwitcherIndex(FoundSwitcherIndex);
 		return true;
 	}
 
 	return false;
 }
 
-void UMainUiLayoutWidget::SetWidgetForLayer(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens)
+void UMainUiLayoutWidget::UpdateOpaqueScreen(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens)
 {
-	if (bCleanUpExistingScreens)
+	const int32 TargetLayerIndex = GetLayerIndex(UiScreenInfo.LayerId);
+
+	// The opaque screen is replaced or removed, lower layers have to be visible during the transition already
+	if (bCleanUpExistingScreens || (OpaqueScreenLayerIndex != INDEX_NONE && TargetLayerIndex <= OpaqueScreenLayerIndex))
 	{
-		for (const FLayerInfo& Layer : Layers)
+		OpaqueScreenLayerIndex = INDEX_NONE;
+		OpaqueScreenClass = nullptr;
+		SuspendLayersBelow(INDEX_NONE);
+	}
+
+	// Lower layers stay visible until it's displayed, so it transitions in over them
+	if (UiScreenInfo.bIsOpaqueFullscreen && TargetLayerIndex != INDEX_NONE)
+	{
+		OpaqueScreenLayerIndex = TargetLayerIndex;
+		OpaqueScreenClass = UiScreenInfo.ScreenClass.Get();
+	}
+}
+
+void UMainUiLayoutWidget::SuspendLayersBelow(const int32 LayerIndex)
+{
+	for (int32 Index = 0; Index < Layers.Num(); ++Index)
+	{
+		if (IsValid(Layers[Index].LayerWidget))
 		{
-			TObjectPtr<ULayerWidget> LayerWidget = Layer.LayerWidget;
-			if (IsValid(LayerWidget))
-			{
-				LayerWidget->ClearWidgets();
-			}
+			Layers[Index].LayerWidget->SetSuspended(Index < LayerIndex);
 		}
 	}
+}
+
+void UMainUiLayoutWidget::SetWidgetForLayer(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens)
+{
+	UpdateOpaqueScreen(UiScreenInfo, bCleanUpExistingScreens);
+
+	if (bCleanUpExistingScreens)
+	{
+		ClearAllLayers();
+	}
 	else
 	{
 		RemoveScreensFromHigherLayer(UiScreenInfo);
@@ -92,19 +147,50 @@ void UMainUiLayoutWidget::SetWidgetForLayer(const FUiScreenInfo& UiScreenInfo, c
 
 	if (IsValid(LayerWidget))
 	{
-		LayerWidget->AddWidget(UiScreenInfo.ScreenClass.Get());
+		if (UiScreenInfo.bConstructIncrementally)
+		{
+			LayerWidget->AddWidgetIncrementally(UiScreenInfo.ScreenClass.Get());
+		}
+		else
+		{
+			LayerWidget->AddWidget(UiScreenInfo.ScreenClass.Get());
+		}
 	}
 }
 
-void UMainUiLayoutWidget::RemoveScreensFromHigherLayer(const FUiScreenInfo& UiScreenInfo)
+void UMainUiLayoutWidget::BeginOutgoingTransition(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens)
 {
-	const FGameplayTag TargetLayerId = UiScreenInfo.LayerId;
+	UpdateOpaqueScreen(UiScreenInfo, bCleanUpExistingScreens);
+
+	if (bCleanUpExistingScreens)
+	{
+		// Screens below a placeholder would survive the cleanup, so the target layer is just cleared as well
+		ClearAllLayers();
+		return;
+	}
 
-	const int32 TargetLayerIndex = Layers.IndexOfByPredicate(
-		[&TargetLayerId](const FLayerInfo& Info)
+	RemoveScreensFromHigherLayer(UiScreenInfo);
+	if (ULayerWidget* LayerWidget = GetLayerForScreenInfo(UiScreenInfo))
+	{
+		LayerWidget->ShowPlaceholder();
+	}
+}
+
+void UMainUiLayoutWidget::RemoveLayerPlaceholders()
+{
+	for (const FLayerInfo& Layer : Layers)
+	{
+		if (IsValid(Layer.LayerWidget))
 		{
-			return Info.LayerId == TargetLayerId;
-		});
+			Layer.LayerWidget->RemovePlaceholder();
+		}
+	}
+}
+
+void UMainUiLayoutWidget::RemoveScreensFromHigherLayer(const FUiScreenInfo& UiScreenInfo)
+{
+	const FGameplayTag TargetLayerId = UiScreenInfo.LayerId;
+	const int32 TargetLayerIndex = GetLayerIndex(TargetLayerId);
 
 	if (TargetLayerIndex == INDEX_NONE)
 	{
@@ -138,6 +224,8 @@ void UMainUiLayoutWidget::NativeDestruct()
 		if (IsValid(LayerWidget))
 		{
 			LayerWidget->OnDisplayedWidgetChanged().RemoveAll(this);
+			LayerWidget->OnWidgetAdded().RemoveAll(this);
+			LayerWidget->SetSuspended(false);
 			LayerWidget->ClearWidgets();
 		}
 	}
@@ -145,10 +233,23 @@ void UMainUiLayoutWidget::NativeDestruct()
 	Super::NativeConstruct();
 }
 
-void UMainUiLayoutWidget::OnDisplayedWidgetChanged(UCommonActivatableWidget* CommonActivatableWidget)
+void UMainUiLayoutWidget::OnDisplayedWidgetChanged(UCommonActivatableWidget* CommonActivatableWidget, const FGameplayTag LayerId)
 {
 	CurrentScreenWidget = CommonActivatableWidget;
-	OnDisplayedWidgetChangedDelegate.ExecuteIfBound(CommonActivatableWidget);
+
+	// Suspended once the opaque screen finished transitioning in, resumed as soon as anything else is displayed on its layer
+	if (OpaqueScreenLayerIndex != INDEX_NONE && GetLayerIndex(LayerId) == OpaqueScreenLayerIndex)
+	{
+		const bool bOpaqueScreenDisplayed = CommonActivatableWidget && CommonActivatableWidget->GetClass() == OpaqueScreenClass;
+		SuspendLayersBelow(bOpaqueScreenDisplayed ? OpaqueScreenLayerIndex : INDEX_NONE);
+	}
+
+	OnDisplayedWidgetChangedDelegate.ExecuteIfBound(CommonActivatableWidget, LayerId);
+}
+
+void UMainUiLayoutWidget::OnLayerWidgetAdded(UCommonActivatableWidget& AddedWidget, const FGameplayTag LayerId)
+{
+	OnWidgetAddedDelegate.ExecuteIfBound(AddedWidget, LayerId);
 }
 
 void UMainUiLayoutWidget::RegisterLayer(FGameplayTag LayerTag, ULayerWidget* LayerWidget)
@@ -164,15 +265,16 @@ void UMainUiLayoutWidget::RegisterLayer(FGameplayTag LayerTag, ULayerWidget* Lay
 		return;
 	}
 
-	if (Layers.FindByPredicate([&LayerTag](const FLayerInfo& Info) { return Info.LayerId == LayerTag; }))
+	if (LayerIndexById.Contains(LayerTag))
 	{
 		UE_LOG(LogUiScreenFramework, Warning, TEXT("%hs: Layer %s is already registered."), __FUNCTION__, *LayerTag.ToString());
 		return;
 	}
 
-	LayerWidget->OnDisplayedWidgetChanged().AddUObject(this, &UMainUiLayoutWidget::OnDisplayedWidgetChanged);
+	LayerWidget->OnDisplayedWidgetChanged().AddUObject(this, &UMainUiLayoutWidget::OnDisplayedWidgetChanged, LayerTag);
+	LayerWidget->OnWidgetAdded().AddUObject(this, &UMainUiLayoutWidget::OnLayerWidgetAdded, LayerTag);
 
-	Layers.Emplace(FLayerInfo{LayerTag, LayerWidget});
+	LayerIndexById.Add(LayerTag, Layers.Emplace(FLayerInfo{LayerTag, LayerWidget}));
 }
 
 void UMainUiLayoutWidget::RegisterTooltipLayer(UOverlay* LayerWidget)
@@ -6,12 +6,20 @@
 #include "Rendering/DrawElements.h"
 #include "Subsystems/IndicatorManagerSubsystem.h"
 #include "SceneView.h"
+#include "Widgets/Images/SImage.h"
 #include "Widgets/Layout/SBox.h"
 #include "Engine/AssetManager.h"
 #include "Engine/GameViewportClient.h"
 #include "Helpers/IndicatorProjectionHelper.h"
+#include "Helpers/IndicatorWorkloadRecorder.h"
+#include "Helpers/UiStreamingHelper.h"
+#include "Logging/UiScreenFrameworkTrace.h"
 #include "View/MVVMView.h"
 
+TRACE_DECLARE_INT_COUNTER(UiIndicatorCount, TEXT("UiScreenFramework/Indicators"));
+TRACE_DECLARE_INT_COUNTER(UiIndicatorSlotCount, TEXT("UiScreenFramework/Indicator Slots"));
+TRACE_DECLARE_INT_COUNTER(UiIndicatorPendingLoadCount, TEXT("UiScreenFramework/Indicator Pending Loads"));
+
 namespace EArrowDirection
 {
 	enum Type
@@ -46,6 +54,9 @@ void SIndicatorCanvas::AddReferencedObjects(FReferenceCollector& Collector)
 {
 	Collector.AddReferencedObjects(AllIndicators);
 	Collector.AddReferencedObjects(InactiveIndicators);
+#if !UE_BUILD_SHIPPING
+	Collector.AddReferencedObjects(ReplayIndicators);
+#endif
 	IndicatorPool.AddReferencedObjects(Collector);
 }
 
@@ -85,7 +96,7 @@ void SIndicatorCanvas::FSlot::UpdateTransition()
 
 void SIndicatorCanvas::FSlot::RefreshVisibility() const
 {
-	const bool bIsVisible = (bIsIndicatorVisible || bInTransition) && bHasValidScreenPosition;
+	const bool bIsVisible = (bIsIndicatorVisible || bInTransition) && bHasValidScreenPosition && !bLodHidden;
 	GetWidget()->SetVisibility(bIsVisible ? EVisibility::SelfHitTestInvisible : EVisibility::Collapsed);
 	UE_LOG(LogUIIndicatorPanel, VeryVerbose, TEXT("RefreshVisibility Widget %s, Visibility %s"), *GetNameSafe(IndicatorPtr->IndicatorWidget.Get()),
 		bIsVisible ? TEXT("true") : TEXT("false"));
@@ -116,7 +127,8 @@ void SIndicatorCanvas::Construct(const FArguments& InArgs, const FLocalPlayerCon
 	LocalPlayerContext = InLocalPlayerContext;
 	ScreenEdgeMarkersTrackArea = InScreenEdgeMarkersTrackArea;
 
-	IndicatorPool.SetWorld(LocalPlayerContext.GetWorld());
+	// The workload replay creates a canvas without a player
+	IndicatorPool.SetWorld(LocalPlayerContext.IsInitialized() ? LocalPlayerContext.GetWorld() : nullptr);
 
 	SetCanTick(false);
 	SetVisibility(EVisibility::SelfHitTestInvisible);
@@ -127,6 +139,7 @@ void SIndicatorCanvas::Construct(const FArguments& InArgs, const FLocalPlayerCon
 EActiveTimerReturnType SIndicatorCanvas::UpdateCanvas(double InCurrentTime, float InDeltaTime)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SIndicatorCanvas_UpdateCanvas);
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiIndicator UpdateCanvas"));
 	if (!OptionalPaintGeometry.IsSet())
 	{
 		return EActiveTimerReturnType::Continue;
@@ -168,71 +181,19 @@ EActiveTimerReturnType SIndicatorCanvas::UpdateCanvas(double InCurrentTime, floa
 		{
 			SetShowAnyIndicators(true);
 
-			bool IndicatorsChanged = false;
-
-			for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
+#if !UE_BUILD_SHIPPING
+			if (IndicatorWorkloadRecorder::IsRecording())
 			{
-				SIndicatorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
-				UBaseIndicatorViewModel* IndicatorViewModel = CurChild.IndicatorPtr.Get();
+				IndicatorWorkloadRecorder::RecordFrame(ProjectionData, GeometrySize, ScreenEdgeMarkersTrackArea);
+			}
+#endif
 
-				if (IndicatorViewModel)
+			// Input is gathered separately from the projection, so it can be recorded and replayed without the actors
+			const bool IndicatorsChanged = UpdateIndicators(ProjectionData, GeometrySize, InDeltaTime,
+				[](int32, const UBaseIndicatorViewModel& IndicatorViewModel, FIndicatorProjectionInput& OutProjectionInput)
 				{
-					CurChild.UpdateVisibilityStatus(IndicatorViewModel->GetIndicatorVisibility(), InDeltaTime);
-
-					if (!CurChild.GetIsIndicatorVisible())
-					{
-						IndicatorsChanged |= CurChild.bIsDirty();
-						CurChild.ClearDirtyFlag();
-						continue;
-					}
-
-					// If the indicator changed clamp status between updates, alert the indicator and mark the indicators as changed
-					if (CurChild.WasIndicatorClampedStatusChanged())
-					{
-						//Indicator->OnIndicatorClampedStatusChanged(CurChild.WasIndicatorClamped());
-						CurChild.ClearIndicatorClampedStatusChangedFlag();
-						IndicatorsChanged = true;
-					}
-
-					FVector2D OutScreenPosition;
-					bool bIsOnTheTrack = false;
-					float TrackArrowAngle = 0.f;
-					FVector WorldPosition;
-
-					const bool Success = IndicatorProjectionHelper::Project(*IndicatorViewModel, ProjectionData, GeometrySize, ScreenEdgeMarkersTrackArea,
-						OutScreenPosition, bIsOnTheTrack, TrackArrowAngle, WorldPosition);
-
-					if (!Success)
-					{
-						CurChild.SetHasValidScreenPosition(false);
-						CurChild.SetInFrontOfCamera(false);
-
-						IndicatorsChanged |= CurChild.bIsDirty();
-						CurChild.ClearDirtyFlag();
-						continue;
-					}
-
-					IndicatorViewModel->SetIsIndicatorClamped(bIsOnTheTrack);
-					IndicatorViewModel->SetClampAngle(TrackArrowAngle);
-
-					CurChild.SetInFrontOfCamera(Success);
-					CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || IndicatorViewModel->GetClampToScreen());
-
-					if (CurChild.HasValidScreenPosition())
-					{
-						// Only dirty the screen position if we can actually show this indicator.
-						CurChild.SetScreenPosition(OutScreenPosition);
-
-						const double Depth = FVector::DistSquared2D(ProjectionData.ViewOrigin, WorldPosition);
-						CurChild.SetDepth(Depth);
-					}
-
-					CurChild.SetPriority(IndicatorViewModel->GetPriority());
-
-					IndicatorsChanged |= CurChild.bIsDirty();
-					CurChild.ClearDirtyFlag();
-				}
-			}
+					return IndicatorProjectionHelper::GatherProjectionInput(IndicatorViewModel, OutProjectionInput);
+				});
 
 			if (IndicatorsChanged)
 			{
@@ -249,6 +210,13 @@ EActiveTimerReturnType SIndicatorCanvas::UpdateCanvas(double InCurrentTime, floa
 		SetShowAnyIndicators(false);
 	}
 
+	TRACE_COUNTER_SET(UiIndicatorCount, AllIndicators.Num());
+	TRACE_COUNTER_SET(UiIndicatorSlotCount, CanvasChildren.Num());
+	TRACE_COUNTER_SET(UiIndicatorPendingLoadCount, PendingIndicatorLoads.Num());
+	CSV_CUSTOM_STAT(UiScreenFramework, IndicatorCount, AllIndicators.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(UiScreenFramework, IndicatorSlotCount, CanvasChildren.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(UiScreenFramework, IndicatorPendingLoadCount, PendingIndicatorLoads.Num(), ECsvCustomStatOp::Set);
+
 	if (AllIndicators.Num() == 0)
 	{
 		TickHandle.Reset();
@@ -260,6 +228,160 @@ EActiveTimerReturnType SIndicatorCanvas::UpdateCanvas(double InCurrentTime, floa
 	}
 }
 
+bool SIndicatorCanvas::UpdateIndicators(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, float InDeltaTime,
+	TFunctionRef<bool(int32 ChildIndex, const UBaseIndicatorViewModel& IndicatorViewModel, FIndicatorProjectionInput& OutProjectionInput)> GatherInput)
+{
+	// The view projection matrix is computed once for all indicators of the frame
+	const IndicatorProjectionHelper::FIndicatorProjectionView ProjectionView(ProjectionData);
+	bool IndicatorsChanged = false;
+
+#if !UE_BUILD_SHIPPING
+	const bool bRecordWorkload = IndicatorWorkloadRecorder::IsRecording();
+#endif
+
+	for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
+	{
+		SIndicatorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
+		UBaseIndicatorViewModel* IndicatorViewModel = CurChild.IndicatorPtr.Get();
+
+		if (IndicatorViewModel)
+		{
+			CurChild.UpdateVisibilityStatus(IndicatorViewModel->GetIndicatorVisibility(), InDeltaTime);
+
+			if (!CurChild.GetIsIndicatorVisible())
+			{
+				IndicatorsChanged |= CurChild.bIsDirty();
+				CurChild.ClearDirtyFlag();
+				continue;
+			}
+
+			// If the indicator changed clamp status between updates, alert the indicator and mark the indicators as changed
+			if (CurChild.WasIndicatorClampedStatusChanged())
+			{
+				//Indicator->OnIndicatorClampedStatusChanged(CurChild.WasIndicatorClamped());
+				CurChild.ClearIndicatorClampedStatusChangedFlag();
+				IndicatorsChanged = true;
+			}
+
+			FVector2D OutScreenPosition;
+			bool bIsOnTheTrack = false;
+			float TrackArrowAngle = 0.f;
+			FVector WorldPosition;
+
+			FIndicatorProjectionInput ProjectionInput;
+			const bool bHasProjectionInput = GatherInput(ChildIndex, *IndicatorViewModel, ProjectionInput);
+			const bool Success = bHasProjectionInput && IndicatorProjectionHelper::ProjectInput(ProjectionInput, ProjectionView, ScreenSize,
+				ScreenEdgeMarkersTrackArea, OutScreenPosition, bIsOnTheTrack, TrackArrowAngle, WorldPosition);
+
+#if !UE_BUILD_SHIPPING
+			if (bRecordWorkload && bHasProjectionInput)
+			{
+				IndicatorWorkloadRecorder::RecordIndicator(ProjectionInput, Success, OutScreenPosition, bIsOnTheTrack);
+			}
+#endif
+
+			if (!Success)
+			{
+				CurChild.SetHasValidScreenPosition(false);
+				CurChild.SetInFrontOfCamera(false);
+
+				IndicatorsChanged |= CurChild.bIsDirty();
+				CurChild.ClearDirtyFlag();
+				continue;
+			}
+
+			IndicatorViewModel->SetIsIndicatorClamped(bIsOnTheTrack);
+			IndicatorViewModel->SetClampAngle(TrackArrowAngle);
+
+			CurChild.SetInFrontOfCamera(Success);
+			CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || IndicatorViewModel->GetClampToScreen());
+
+			if (CurChild.HasValidScreenPosition())
+			{
+				// Only dirty the screen position if we can actually show this indicator.
+				CurChild.SetScreenPosition(OutScreenPosition);
+
+				const double Depth = FVector::DistSquared2D(ProjectionData.ViewOrigin, WorldPosition);
+				CurChild.SetDepth(Depth);
+
+				if (IndicatorViewModel->HasLods())
+				{
+					UpdateIndicatorLod(CurChild, *IndicatorViewModel, FVector::Dist(ProjectionData.ViewOrigin, WorldPosition));
+				}
+			}
+
+			CurChild.SetPriority(IndicatorViewModel->GetPriority());
+
+			IndicatorsChanged |= CurChild.bIsDirty();
+			CurChild.ClearDirtyFlag();
+		}
+	}
+
+	return IndicatorsChanged;
+}
+
+#if !UE_BUILD_SHIPPING
+void SIndicatorCanvas::ReplayFrame(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& InScreenEdgeMarkersTrackArea,
+	TConstArrayView<FIndicatorProjectionInput> ProjectionInputs, float InDeltaTime)
+{
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiIndicator ReplayFrame"));
+	ScreenEdgeMarkersTrackArea = InScreenEdgeMarkersTrackArea;
+
+	// Replay indicators only get a host, the cost of the indicator widgets themselves isn't part of the recording
+	while (ReplayIndicators.Num() < ProjectionInputs.Num())
+	{
+		UBaseIndicatorViewModel* ReplayIndicator = NewObject<UBaseIndicatorViewModel>(GetTransientPackage());
+		ReplayIndicators.Add(ReplayIndicator);
+
+		AddActorSlot(ReplayIndicator)
+		[
+			SAssignNew(ReplayIndicator->CanvasHost, SBox)
+		];
+	}
+
+	// Slots beyond the inputs of this frame fade out like indicators leaving the view
+	for (int32 IndicatorIndex = 0; IndicatorIndex < ReplayIndicators.Num(); ++IndicatorIndex)
+	{
+		ReplayIndicators[IndicatorIndex]->SetIndicatorVisibility(IndicatorIndex < ProjectionInputs.Num());
+	}
+
+	if (!ensureMsgf(CanvasChildren.Num() == ReplayIndicators.Num(), TEXT("%hs Only canvases created for the replay can replay frames"), __FUNCTION__))
+	{
+		return;
+	}
+
+	const bool IndicatorsChanged = UpdateIndicators(ProjectionData, ScreenSize, InDeltaTime,
+		[ProjectionInputs](const int32 ChildIndex, const UBaseIndicatorViewModel&, FIndicatorProjectionInput& OutProjectionInput)
+		{
+			if (!ProjectionInputs.IsValidIndex(ChildIndex))
+			{
+				return false;
+			}
+
+			OutProjectionInput = ProjectionInputs[ChildIndex];
+			return true;
+		});
+
+	if (IndicatorsChanged)
+	{
+		Invalidate(EInvalidateWidget::Paint);
+	}
+}
+
+bool SIndicatorCanvas::GetReplayedIndicator(const int32 Index, FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack) const
+{
+	if (!ReplayIndicators.IsValidIndex(Index) || !CanvasChildren.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	const FSlot& ReplaySlot = CanvasChildren[Index];
+	OutScreenPosition = ReplaySlot.GetScreenPosition();
+	bOutIsOnTheTrack = ReplayIndicators[Index]->bIsIndicatorClamped;
+	return ReplaySlot.GetInFrontOfCamera();
+}
+#endif
+
 void SIndicatorCanvas::SetShowAnyIndicators(bool bIndicators)
 {
 	if (bShowAnyIndicators != bIndicators)
@@ -379,6 +501,7 @@ void SIndicatorCanvas::OnIndicatorAdded(UBaseIndicatorViewModel* IndicatorViewMo
 {
 	checkf(IndicatorViewModel != nullptr,
 		TEXT("This should never happen with gc.PendingKillEnabled=False. If it's still True, test with -DisablePendingKill to see who's leaking the UIndicatorViewModel objects."));
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiIndicator Add"));
 
 	AllIndicators.Add(IndicatorViewModel);
 	InactiveIndicators.Add(IndicatorViewModel);
@@ -388,6 +511,8 @@ void SIndicatorCanvas::OnIndicatorAdded(UBaseIndicatorViewModel* IndicatorViewMo
 
 void SIndicatorCanvas::OnIndicatorRemoved(UBaseIndicatorViewModel* IndicatorViewModel)
 {
+	UI_SCREEN_TRACE_SCOPE(TEXT("UiIndicator Remove"));
+
 	RemoveIndicatorForEntry(IndicatorViewModel);
 
 	AllIndicators.Remove(IndicatorViewModel);
@@ -396,22 +521,48 @@ void SIndicatorCanvas::OnIndicatorRemoved(UBaseIndicatorViewModel* IndicatorView
 
 void SIndicatorCanvas::AddIndicatorForEntry(UBaseIndicatorViewModel* Indicator)
 {
+	// Indicators with distance bands get their slot right away, the representation is picked on the first canvas update
+	if (Indicator->HasLods())
+	{
+		InactiveIndicators.Remove(Indicator);
+
+		AddActorSlot(Indicator)
+		[
+			SAssignNew(Indicator->CanvasHost, SBox)
+		];
+		return;
+	}
+
 	// Async load the indicator, and pool the results so that it's easy to use and reuse the widgets.
 	TSoftClassPtr<UUserWidget> IndicatorClass = Indicator->GetIndicatorClass();
 	if (!IndicatorClass.IsNull())
 	{
 		TWeakObjectPtr<UBaseIndicatorViewModel> IndicatorPtr(Indicator);
 
-		UAssetManager::GetStreamableManager().RequestAsyncLoad(IndicatorClass.ToSoftObjectPath(),
-			FStreamableDelegate::CreateSP(this, &SIndicatorCanvas::AddIndicatorToSlot, IndicatorClass, IndicatorPtr), FStreamableManager::AsyncLoadHighPriority, false, false,
+		TSharedPtr<FStreamableHandle> IndicatorLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(IndicatorClass.ToSoftObjectPath(),
+			FStreamableDelegate::CreateSP(this, &SIndicatorCanvas::AddIndicatorToSlot, IndicatorClass, IndicatorPtr), UiStreamingHelper::IndicatorPriority, false, false,
 			TEXT("SIndicatorCanvas::AddIndicatorForEntry"));
+
+		// Already loaded classes complete synchronously, nothing to track then
+		if (IndicatorLoadHandle.IsValid() && IndicatorLoadHandle->IsLoadingInProgress())
+		{
+			UI_SCREEN_TRACE_BEGIN_REGION(TEXT("UiIndicator Load %s %s"), *IndicatorClass.GetAssetName(), *Indicator->GetName());
+			PendingIndicatorLoads.Add(IndicatorPtr, MoveTemp(IndicatorLoadHandle));
+		}
 	}
 }
 
 void SIndicatorCanvas::AddIndicatorToSlot(TSoftClassPtr<UUserWidget> IndicatorWidgetClass, TWeakObjectPtr<UBaseIndicatorViewModel> IndicatorViewModelSoft)
 {
+	const bool bWasLoading = PendingIndicatorLoads.Remove(IndicatorViewModelSoft) > 0;
+
 	if (UBaseIndicatorViewModel* IndicatorViewModel = IndicatorViewModelSoft.Get())
 	{
+		if (bWasLoading)
+		{
+			UI_SCREEN_TRACE_END_REGION(TEXT("UiIndicator Load %s %s"), *IndicatorWidgetClass.GetAssetName(), *IndicatorViewModel->GetName());
+		}
+
 		// While async loading this indicator widget we could have removed it.
 		if (!AllIndicators.Contains(IndicatorViewModel))
 		{
@@ -423,14 +574,7 @@ void SIndicatorCanvas::AddIndicatorToSlot(TSoftClassPtr<UUserWidget> IndicatorWi
 		// Create the widget from the pool.
 		if (UUserWidget* IndicatorWidget = IndicatorPool.GetOrCreateInstance(TSubclassOf<UUserWidget>(IndicatorWidgetClass.Get())))
 		{
-			IndicatorViewModel->IndicatorWidget = IndicatorWidget;
-
-			UMVVMView* View = IndicatorWidget->GetExtension<UMVVMView>();
-			if (IsValid(View))
-			{
-				// UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%hs Widget %s does not have a view model %s"), __FUNCTION__, *GetNameSafe(IndicatorWidget), *GetNameSafe(Indicator));
-				View->SetViewModelByClass(IndicatorViewModel);
-			}
+			SetIndicatorWidget(*IndicatorViewModel, IndicatorWidget);
 
 			InactiveIndicators.Remove(IndicatorViewModel);
 
@@ -447,14 +591,28 @@ void SIndicatorCanvas::AddIndicatorToSlot(TSoftClassPtr<UUserWidget> IndicatorWi
 
 void SIndicatorCanvas::RemoveIndicatorForEntry(UBaseIndicatorViewModel* Indicator)
 {
-	if (UUserWidget* IndicatorWidget = Indicator->IndicatorWidget.Get())
+	SetIndicatorWidget(*Indicator, nullptr);
+
+	TSharedPtr<FStreamableHandle> IndicatorLoadHandle;
+	if (PendingIndicatorLoads.RemoveAndCopyValue(Indicator, IndicatorLoadHandle))
 	{
-		Indicator->IndicatorWidget = nullptr;
+		UI_SCREEN_TRACE_END_REGION(TEXT("UiIndicator Load %s %s"), *Indicator->GetIndicatorClass().GetAssetName(), *Indicator->GetName());
+		UiStreamingHelper::CancelOrReleaseHandle(IndicatorLoadHandle);
+	}
+
+	if (FSlot* IndicatorSlot = FindSlotForIndicator(Indicator))
+	{
+		if (IndicatorSlot->PendingLodHandle.IsValid())
+		{
+			UI_SCREEN_TRACE_END_REGION(TEXT("UiIndicator LOD Load %s %d"), *Indicator->GetName(), IndicatorSlot->PendingLodIndex);
+			IndicatorSlot->PendingLodHandle->CancelHandle();
+			IndicatorSlot->PendingLodHandle.Reset();
+		}
 
-		IndicatorPool.Release(IndicatorWidget);
+		ReleaseLodPreloads(*IndicatorSlot);
 	}
 
-	TSharedPtr<SWidget> CanvasHost = Indicator->CanvasHost.Pin();
+	TSharedPtr<SBox> CanvasHost = Indicator->CanvasHost.Pin();
 	if (CanvasHost.IsValid())
 	{
 		RemoveActorSlot(CanvasHost.ToSharedRef());
@@ -503,7 +661,7 @@ void SIndicatorCanvas::GetOffsetAndSize(const UBaseIndicatorViewModel* Indicator
 	FVector2D AllottedSize = FVector2D::ZeroVector;
 
 	//grab the desired size of the child widget
-	TSharedPtr<SWidget> CanvasHost = IndicatorViewModel->CanvasHost.Pin();
+	TSharedPtr<SBox> CanvasHost = IndicatorViewModel->CanvasHost.Pin();
 	if (CanvasHost.IsValid())
 	{
 		OutSize = CanvasHost->GetDesiredSize();
@@ -563,3 +721,224 @@ void SIndicatorCanvas::UpdateActiveTimer()
 		TickHandle = RegisterActiveTimer(0, FWidgetActiveTimerDelegate::CreateSP(this, &SIndicatorCanvas::UpdateCanvas));
 	}
 }
+
+void SIndicatorCanvas::UpdateIndicatorLod(FSlot& IndicatorSlot, UBaseIndicatorViewModel& IndicatorViewModel, const float Distance)
+{
+	const int32 NewLodIndex = UBaseIndicatorViewModel::SelectLodIndex(IndicatorViewModel.GetLodEntries(), IndicatorSlot.LodIndex, Distance, IndicatorViewModel.GetLodHysteresis());
+	if (NewLodIndex == IndicatorSlot.PendingLodIndex)
+	{
+		return;
+	}
+
+	if (NewLodIndex == IndicatorSlot.LodIndex)
+	{
+		// Indicator came back to the displayed band before the pending one finished loading
+		if (IndicatorSlot.PendingLodHandle.IsValid())
+		{
+			IndicatorSlot.PendingLodHandle->CancelHandle();
+			IndicatorSlot.PendingLodHandle.Reset();
+		}
+		IndicatorSlot.PendingLodIndex = INDEX_NONE;
+		return;
+	}
+
+	ApplyIndicatorLod(IndicatorSlot, IndicatorViewModel, NewLodIndex);
+}
+
+void SIndicatorCanvas::ApplyIndicatorLod(FSlot& IndicatorSlot, UBaseIndicatorViewModel& IndicatorViewModel, const int32 LodIndex)
+{
+	TSharedPtr<SBox> CanvasHost = IndicatorViewModel.CanvasHost.Pin();
+	if (!CanvasHost.IsValid())
+	{
+		return;
+	}
+
+	const TArray<FIndicatorLodEntry>& LodEntries = IndicatorViewModel.GetLodEntries();
+	const FIndicatorLodEntry* LodEntry = LodEntries.IsValidIndex(LodIndex) ? &LodEntries[LodIndex] : nullptr;
+	const EIndicatorLodRepresentation Representation = LodEntry ? LodEntry->Representation : EIndicatorLodRepresentation::Hidden;
+
+	UE_LOG(LogUIIndicatorPanel, Verbose, TEXT("%hs Indicator %s, LodIndex %d -> %d"), __FUNCTION__, *GetNameSafe(&IndicatorViewModel), IndicatorSlot.LodIndex, LodIndex);
+
+	switch (Representation)
+	{
+	case EIndicatorLodRepresentation::Widget:
+		{
+			UClass* LodWidgetClass = LodEntry->WidgetClass.Get();
+			if (!LodWidgetClass)
+			{
+				if (LodEntry->WidgetClass.IsNull())
+				{
+					UE_LOG(LogUIIndicatorPanel, Warning, TEXT("%hs Indicator %s has no widget class set for LOD %d"), __FUNCTION__, *GetNameSafe(&IndicatorViewModel), LodIndex);
+					return;
+				}
+
+				// Keep the current representation until the widget class of the new band is streamed in
+				if (IndicatorSlot.PendingLodHandle.IsValid())
+				{
+					UI_SCREEN_TRACE_END_REGION(TEXT("UiIndicator LOD Load %s %d"), *IndicatorViewModel.GetName(), IndicatorSlot.PendingLodIndex);
+					IndicatorSlot.PendingLodHandle->CancelHandle();
+				}
+
+				UI_SCREEN_TRACE_BEGIN_REGION(TEXT("UiIndicator LOD Load %s %d"), *IndicatorViewModel.GetName(), LodIndex);
+				IndicatorSlot.PendingLodIndex = LodIndex;
+				IndicatorSlot.PendingLodHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(LodEntry->WidgetClass.ToSoftObjectPath(),
+					FStreamableDelegate::CreateSP(this, &SIndicatorCanvas::OnLodWidgetClassLoaded, TWeakObjectPtr<UBaseIndicatorViewModel>(&IndicatorViewModel), LodIndex),
+					UiStreamingHelper::IndicatorPriority, false, false, TEXT("SIndicatorCanvas::ApplyIndicatorLod"));
+				return;
+			}
+
+			const UUserWidget* CurrentWidget = IndicatorViewModel.IndicatorWidget.Get();
+			if (!CurrentWidget || CurrentWidget->GetClass() != LodWidgetClass)
+			{
+				UUserWidget* LodWidget = IndicatorPool.GetOrCreateInstance(TSubclassOf<UUserWidget>(LodWidgetClass));
+				if (!LodWidget)
+				{
+					return;
+				}
+
+				SetIndicatorWidget(IndicatorViewModel, LodWidget);
+				CanvasHost->SetContent(LodWidget->TakeWidget());
+			}
+		}
+		break;
+	case EIndicatorLodRepresentation::Brush:
+		{
+			SetIndicatorWidget(IndicatorViewModel, nullptr);
+
+			const bool bWasShowingImage = IndicatorSlot.LodImage.IsValid() && LodEntries.IsValidIndex(IndicatorSlot.LodIndex)
+				&& LodEntries[IndicatorSlot.LodIndex].Representation == EIndicatorLodRepresentation::Brush;
+			if (!IndicatorSlot.LodImage.IsValid())
+			{
+				IndicatorSlot.LodImage = SNew(SImage);
+			}
+
+			IndicatorSlot.LodBrush = LodEntry->Brush;
+			IndicatorSlot.LodImage->SetImage(&IndicatorSlot.LodBrush);
+			if (!bWasShowingImage)
+			{
+				CanvasHost->SetContent(IndicatorSlot.LodImage.ToSharedRef());
+			}
+		}
+		break;
+	case EIndicatorLodRepresentation::Hidden:
+		SetIndicatorWidget(IndicatorViewModel, nullptr);
+		CanvasHost->SetContent(SNullWidget::NullWidget);
+		break;
+	}
+
+	IndicatorSlot.LodIndex = LodIndex;
+	IndicatorSlot.PendingLodIndex = INDEX_NONE;
+	IndicatorSlot.PendingLodHandle.Reset();
+	IndicatorSlot.SetLodHidden(Representation == EIndicatorLodRepresentation::Hidden);
+
+	PreloadAdjacentLods(IndicatorSlot, IndicatorViewModel, LodIndex);
+}
+
+void SIndicatorCanvas::OnLodWidgetClassLoaded(TWeakObjectPtr<UBaseIndicatorViewModel> IndicatorViewModelWeak, const int32 LodIndex)
+{
+	UBaseIndicatorViewModel* IndicatorViewModel = IndicatorViewModelWeak.Get();
+	if (!IndicatorViewModel)
+	{
+		return;
+	}
+
+	// The indicator could have been removed or could have moved to another band while loading
+	FSlot* IndicatorSlot = FindSlotForIndicator(IndicatorViewModel);
+	if (IndicatorSlot && IndicatorSlot->PendingLodIndex == LodIndex)
+	{
+		UI_SCREEN_TRACE_END_REGION(TEXT("UiIndicator LOD Load %s %d"), *IndicatorViewModel->GetName(), LodIndex);
+		IndicatorSlot->PendingLodHandle.Reset();
+		ApplyIndicatorLod(*IndicatorSlot, *IndicatorViewModel, LodIndex);
+	}
+}
+
+void SIndicatorCanvas::PreloadAdjacentLods(FSlot& IndicatorSlot, const UBaseIndicatorViewModel& IndicatorViewModel, const int32 LodIndex)
+{
+	TArray<FSoftObjectPath, TInlineAllocator<2>> AdjacentLodPaths;
+	const TArray<FIndicatorLodEntry>& LodEntries = IndicatorViewModel.GetLodEntries();
+	for (const int32 AdjacentLodIndex : {LodIndex - 1, LodIndex + 1})
+	{
+		if (!LodEntries.IsValidIndex(AdjacentLodIndex))
+		{
+			continue;
+		}
+
+		const FIndicatorLodEntry& AdjacentLodEntry = LodEntries[AdjacentLodIndex];
+		if (AdjacentLodEntry.Representation != EIndicatorLodRepresentation::Widget || AdjacentLodEntry.WidgetClass.IsNull())
+		{
+			continue;
+		}
+
+		const FSoftObjectPath WidgetClassPath = AdjacentLodEntry.WidgetClass.ToSoftObjectPath();
+		if (AdjacentLodPaths.Contains(WidgetClassPath))
+		{
+			continue;
+		}
+		AdjacentLodPaths.Add(WidgetClassPath);
+
+		FLodPreload& LodPreload = LodPreloads.FindOrAdd(WidgetClassPath);
+		if (!LodPreload.Handle.IsValid())
+		{
+			LodPreload.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPath, FStreamableDelegate(), UiStreamingHelper::IndicatorPreloadPriority,
+				false, false, TEXT("SIndicatorCanvas::PreloadAdjacentLods"));
+		}
+		++LodPreload.NumReferences;
+	}
+
+	// References of the new bands are taken first, so classes still adjacent aren't released and requested again
+	ReleaseLodPreloads(IndicatorSlot);
+	IndicatorSlot.PreloadedLodPaths = MoveTemp(AdjacentLodPaths);
+}
+
+void SIndicatorCanvas::ReleaseLodPreloads(FSlot& IndicatorSlot)
+{
+	for (const FSoftObjectPath& WidgetClassPath : IndicatorSlot.PreloadedLodPaths)
+	{
+		FLodPreload* LodPreload = LodPreloads.Find(WidgetClassPath);
+		if (LodPreload && --LodPreload->NumReferences <= 0)
+		{
+			UiStreamingHelper::CancelOrReleaseHandle(LodPreload->Handle);
+			LodPreloads.Remove(WidgetClassPath);
+		}
+	}
+
+	IndicatorSlot.PreloadedLodPaths.Reset();
+}
+
+void SIndicatorCanvas::SetIndicatorWidget(UBaseIndicatorViewModel& IndicatorViewModel, UUserWidget* NewIndicatorWidget)
+{
+	UUserWidget* PreviousIndicatorWidget = IndicatorViewModel.IndicatorWidget.Get();
+	if (PreviousIndicatorWidget == NewIndicatorWidget)
+	{
+		return;
+	}
+
+	if (PreviousIndicatorWidget)
+	{
+		IndicatorPool.Release(PreviousIndicatorWidget);
+	}
+
+	IndicatorViewModel.IndicatorWidget = NewIndicatorWidget;
+
+	if (NewIndicatorWidget)
+	{
+		UMVVMView* View = NewIndicatorWidget->GetExtension<UMVVMView>();
+		if (IsValid(View))
+		{
+			View->SetViewModelByClass(&IndicatorViewModel);
+		}
+	}
+}
+
+SIndicatorCanvas::FSlot* SIndicatorCanvas::FindSlotForIndicator(const UBaseIndicatorViewModel* IndicatorViewModel)
+{
+	for (int32 SlotIdx = 0; SlotIdx < CanvasChildren.Num(); ++SlotIdx)
+	{
+		if (CanvasChildren[SlotIdx].IndicatorPtr.Get() == IndicatorViewModel)
+		{
+			return &CanvasChildren[SlotIdx];
+		}
+	}
+
+	return nullptr;
+}
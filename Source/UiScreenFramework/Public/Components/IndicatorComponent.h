@@ -25,31 +25,50 @@ public:
 
 	void AddIndicator(bool bMakeVisible = false);
 	virtual void RemoveIndicator();
-	const TObjectPtr<UBaseIndicatorViewModel>& GetIndicator() const { return IndicatorViewModel; }
+
+	// View model is created the first time the indicator is added, it stays nullptr on dedicated servers
+	const TObjectPtr<UBaseIndicatorViewModel>& GetIndicator() const { return IndicatorViewModelInstance; }
 
 	// Set visibility of indicator
 	UFUNCTION(BlueprintCallable)
 	virtual void SetIndicatorVisibility(bool bInVisibility, EIndicatorVisibilityPriority InPriority = EIndicatorVisibilityPriority::AlwaysAllowEnable);
 
-	bool GetIndicatorVisibility() const { return IndicatorViewModel->GetIndicatorVisibility(); }
+	bool GetIndicatorVisibility() const { return IndicatorViewModelInstance && IndicatorViewModelInstance->GetIndicatorVisibility(); }
 
-	TSoftClassPtr<UUserWidget> GetIndicatorClass() const { return IndicatorViewModel->GetIndicatorClass(); }
-	TObjectPtr<UBaseIndicatorViewModel> GetIndicatorViewModel() const { return IndicatorViewModel; }
+	TSoftClassPtr<UUserWidget> GetIndicatorClass() const;
+	TObjectPtr<UBaseIndicatorViewModel> GetIndicatorViewModel() const { return IndicatorViewModelInstance; }
 
 	void SetIndicatorClass(TSoftClassPtr<UUserWidget> InIndicatorWidgetClass);
 
-	void SetIndicatorWorldOffset(const FVector& InWorldOffset) const;
+	void SetIndicatorWorldOffset(const FVector& InWorldOffset);
 
 	template <typename T>
 	T* GetIndicatorViewModelByClass() const
 	{
-		return Cast<T>(IndicatorViewModel);
+		return Cast<T>(IndicatorViewModelInstance);
 	}
 
 protected:
-	// View Model that keeps all data for the indicator
-	UPROPERTY(Instanced, EditAnywhere, BlueprintReadOnly)
-	TObjectPtr<UBaseIndicatorViewModel> IndicatorViewModel;
+	/** Creates the view model of IndicatorViewModelClass if it doesn't exist yet. Returns nullptr on dedicated servers. */
+	UBaseIndicatorViewModel* GetOrCreateIndicatorViewModel();
+
+	// Class of the view model created the first time the indicator is added, UBaseIndicatorViewModel if not set
+	UPROPERTY(EditAnywhere)
+	TSubclassOf<UBaseIndicatorViewModel> IndicatorViewModelClass;
+
+#if WITH_EDITORONLY_DATA
+	// View model saved as an instanced subobject of every component, migrated to IndicatorViewModelClass and IndicatorConfig on load
+	UPROPERTY(Instanced, meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorViewModelClass and IndicatorConfig instead"))
+	TObjectPtr<UBaseIndicatorViewModel> IndicatorViewModel_DEPRECATED;
+#endif
+
+	// Shared static configuration passed to the view model
+	UPROPERTY(EditAnywhere)
+	TObjectPtr<const UIndicatorConfigData> IndicatorConfig;
+
+	// View Model that keeps all dynamic data for the indicator, created lazily
+	UPROPERTY(Transient, BlueprintReadOnly)
+	TObjectPtr<UBaseIndicatorViewModel> IndicatorViewModelInstance;
 
 	// Indicates whether indicator should be added automatically on begin play
 	UPROPERTY(EditAnywhere)
@@ -60,5 +79,9 @@ protected:
 	bool bAutoVisible = false;
 
 private:
+#if WITH_EDITORONLY_DATA
+	void MigrateDeprecatedViewModel();
+#endif
+
 	bool bAddedIndicator = false;
 };
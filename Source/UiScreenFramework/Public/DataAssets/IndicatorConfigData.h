@@ -0,0 +1,88 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Enums/IndicatorCategory.h"
+#include "Enums/IndicatorProjectionMode.h"
+#include "Structs/IndicatorLodEntry.h"
+#include "Types/SlateEnums.h"
+#include "IndicatorConfigData.generated.h"
+
+class UUserWidget;
+
+/**
+ * Static configuration of an indicator type. Shared by reference between all indicators of that type,
+ * per actor indicator view models keep only their dynamic state.
+ */
+UCLASS(BlueprintType)
+class UISCREENFRAMEWORK_API UIndicatorConfigData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Indicator category identifier
+	UPROPERTY(EditDefaultsOnly)
+	EIndicatorCategory IndicatorCategory = EIndicatorCategory::Default;
+
+	// Indicator user widget class
+	UPROPERTY(EditDefaultsOnly)
+	TSoftClassPtr<UUserWidget> IndicatorWidgetClass;
+
+	// Indicator's Projection Mode on the screen
+	UPROPERTY(EditDefaultsOnly)
+	EIndicatorProjectionMode ProjectionMode = EIndicatorProjectionMode::ActorBoundingBox;
+
+	// Horizontal alignment 
+	UPROPERTY(EditDefaultsOnly)
+	TEnumAsByte<EHorizontalAlignment> HAlignment = HAlign_Center;
+
+	// Vertical alignment 
+	UPROPERTY(EditDefaultsOnly)
+	TEnumAsByte<EVerticalAlignment> VAlignment = VAlign_Center;
+
+	// Anchor point for indicator that is located on its owner bounding box (default value is top of bounding box)
+	UPROPERTY(EditDefaultsOnly)
+	FVector BoundingBoxAnchor = FVector(0.5f, 0.5f, 1.0f);
+
+	// Additional offset on screen space
+	UPROPERTY(EditDefaultsOnly)
+	FVector2D ScreenSpaceOffset = FVector2D(0.0f, 0.0f);
+
+	// Additional Offset in World (default value make indicator move up a little bit)
+	UPROPERTY(EditDefaultsOnly)
+	FVector WorldPositionOffset = FVector(0.0f, 0.0f, 20.0f);
+
+	// Time of transition between indicator's visibility modes
+	UPROPERTY(EditDefaultsOnly)
+	float TransitionTime = .2f;
+
+	// Should indicator stay on screen if its owner is out of screen
+	UPROPERTY(EditDefaultsOnly)
+	bool bClampToScreen = false;
+
+	// Indicates whether indicator should update the distance factor
+	UPROPERTY(EditDefaultsOnly)
+	bool bUpdateDistance = false;
+
+	// Indicates whether indicator has distance visibility condition
+	UPROPERTY(EditDefaultsOnly)
+	bool bHasVisibilityRange = false;
+
+	// Indicates range when player starts seeing indicator
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bHasVisibilityRange || bUpdateDistance"))
+	float VisibilityRangeOuter = 1500.0f;
+
+	// Indicates range when indicator is fully visible
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bHasVisibilityRange || bUpdateDistance"))
+	float VisibilityRangeInner = 1000.0f;
+
+	// Distance based representations ordered from the nearest to the farthest band, when empty IndicatorWidgetClass is always used
+	UPROPERTY(EditDefaultsOnly)
+	TArray<FIndicatorLodEntry> LodEntries;
+
+	// Distance that has to be crossed past a LOD band edge before the representation changes
+	UPROPERTY(EditDefaultsOnly)
+	float LodHysteresis = 150.f;
+};
@@ -7,6 +7,9 @@
 #include "Structs/UiScreenInfo.h"
 #include "UiScreensData.generated.h"
 
+class UUiScreensData;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUiScreensDataChanged, const UUiScreensData* /* ScreensData */);
 
 UCLASS(BlueprintType)
 class UISCREENFRAMEWORK_API UUiScreensData : public UDataAsset
@@ -14,6 +17,13 @@ class UISCREENFRAMEWORK_API UUiScreensData : public UDataAsset
 	GENERATED_BODY()
 
 public:
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** Broadcasted when the asset is edited, so cached lookups built from it can be rebuilt. */
+	FOnUiScreensDataChanged OnScreensDataChanged;
+#endif
+
 	UPROPERTY(EditDefaultsOnly, meta = (TitleProperty = "ScreenId"))
 	TArray<FUiScreenInfo> Screens;
 };
@@ -18,6 +18,18 @@ public:
 	UUiScreensData* GetViewsData() const { return ScreensData.LoadSynchronous(); }
 	float GetTooltipEdgePadding() const { return TooltipEdgePadding; }
 
+	const TSoftClassPtr<UMainUiLayoutWidget>& GetLayoutWidgetSoftClass() const { return LayoutWidgetClass; }
+	const TSoftObjectPtr<UUiScreensData>& GetScreensDataSoftPtr() const { return ScreensData; }
+	const TArray<FGameplayTag>& GetStartupScreens() const { return StartupScreens; }
+	float GetPrefetchIdleDelay() const { return PrefetchIdleDelay; }
+	int32 GetMaxPrefetchedScreens() const { return MaxPrefetchedScreens; }
+	int64 GetPrefetchMemoryBudgetBytes() const { return static_cast<int64>(PrefetchMemoryBudgetKB) * 1024; }
+	int32 GetMaxRetainedScreenViewModels() const { return MaxRetainedScreenViewModels; }
+	float GetViewModelReadyTimeout() const { return ViewModelReadyTimeout; }
+	double GetDeferredTeardownBudgetSeconds() const { return DeferredTeardownBudgetMs / 1000.0; }
+	double GetIncrementalConstructionBudgetSeconds() const { return IncrementalConstructionBudgetMs / 1000.0; }
+	float GetNavigationBudgetMs() const { return NavigationBudgetMs; }
+
 private:
 	/** The class for the main layout widget that hosts all UI layers. Set in config. */
 	UPROPERTY(config, EditAnywhere, Category = "UI")
@@ -27,6 +39,54 @@ private:
 	UPROPERTY(config, EditAnywhere, Category = "UI")
 	TSoftObjectPtr<UUiScreensData> ScreensData;
 
+	/** Screens streamed during the warm-up phase together with the layout and screens data, so the first navigation doesn't wait for them. */
+	UPROPERTY(config, EditAnywhere, Category = "UI", meta = (Categories = "UI.Screen"))
+	TArray<FGameplayTag> StartupScreens;
+
+	/** Time in seconds the current screen has to stay displayed before its likely next screens are prefetched. */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Prefetch", meta = (ClampMin = 0.0, Units = "s"))
+	float PrefetchIdleDelay = 0.5f;
+
+	/** Maximum number of screens kept prefetched at the same time. 0 disables prefetching. */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Prefetch", meta = (ClampMin = 0))
+	int32 MaxPrefetchedScreens = 3;
+
+	/** Memory budget for prefetched screen assets. Prefetches that don't fit are released. */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Prefetch", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 PrefetchMemoryBudgetKB = 16 * 1024;
+
+	/**
+	 * Maximum number of screen view models kept alive for the screen history. Older ones that aren't displayed are snapshotted and rehydrated on back navigation.
+	 * 0 keeps all of them alive, which is the default. View models of screens that only restore SaveGame state on rehydration should opt in.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "UI|ViewModels", meta = (ClampMin = 0))
+	int32 MaxRetainedScreenViewModels = 0;
+
+	/**
+	 * Maximum time a screen waits for the asynchronous initialization of its new view model, the screen is displayed anyway once it passes.
+	 * 0 displays screens without waiting.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "UI|ViewModels", meta = (ClampMin = 0.0, Units = "s"))
+	float ViewModelReadyTimeout = 2.f;
+
+	/**
+	 * Time per frame spent on deinitializing view models and releasing widgets of closed screens.
+	 * Teardown waits for layer transitions to finish, at least one item is torn down per frame.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Teardown", meta = (ClampMin = 0.0, Units = "ms"))
+	float DeferredTeardownBudgetMs = 1.f;
+
+	/**
+	 * Time per frame spent on constructing screens flagged with bConstructIncrementally.
+	 * A construction step that exceeds it isn't split further, the remaining steps continue next frame.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Construction", meta = (ClampMin = 0.0, Units = "ms"))
+	float IncrementalConstructionBudgetMs = 4.f;
+
+	/** Time from a screen change request to the activation of the screen, navigations over it log a warning with their stage breakdown. 0 disables the warning. */
+	UPROPERTY(config, EditAnywhere, Category = "UI|Profiling", meta = (ClampMin = 0.0, Units = "ms"))
+	float NavigationBudgetMs = 100.f;
+
 	/** Minimal distance between edge of the screen and a tooltip edge. */
 	UPROPERTY(config, EditAnywhere, Category = "UI")
 	float TooltipEdgePadding = 20.f;
@@ -0,0 +1,16 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+#include "UObject/ObjectMacros.h"
+#include "IndicatorLodRepresentation.generated.h"
+
+UENUM(BlueprintType)
+enum class EIndicatorLodRepresentation : uint8
+{
+	// Pooled user widget of the configured class
+	Widget,
+	// Single brush drawn by the canvas, no user widget is created
+	Brush,
+	// Indicator is not displayed in this distance band
+	Hidden,
+};
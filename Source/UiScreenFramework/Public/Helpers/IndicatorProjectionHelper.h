@@ -4,6 +4,7 @@
 
 #include "Engine/LocalPlayer.h"
 #include "Kismet/GameplayStatics.h"
+#include "Structs/IndicatorProjectionInput.h"
 #include "Structs/ScreenEdgeMarkersTrackArea.h"
 
 class UCapsuleComponent;
@@ -11,23 +12,52 @@ class UBaseIndicatorViewModel;
 
 namespace IndicatorProjectionHelper
 {
-	bool Project(const UBaseIndicatorViewModel& Indicator, const FSceneViewProjectionData& InProjectionData,
+	// Projection of a view with its view projection matrix computed once, shared by all indicators projected in a frame
+	struct FIndicatorProjectionView
+	{
+		explicit FIndicatorProjectionView(const FSceneViewProjectionData& InProjectionData)
+			: ProjectionData(InProjectionData)
+			, ViewProjectionMatrix(InProjectionData.ComputeViewProjectionMatrix())
+		{
+		}
+
+		const FSceneViewProjectionData& ProjectionData;
+		const FMatrix ViewProjectionMatrix;
+	};
+
+	bool Project(const UBaseIndicatorViewModel& Indicator, const FIndicatorProjectionView& View,
 		const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea, FVector2D& OutScreenPosition,
 		bool& bOutIsOnTheTrack, float& OutTrackArrowAngle, FVector& OutWorldPosition);
 
+	// Reads everything the projection needs from the indicator and its attached actor, false if the actor isn't set
+	bool GatherProjectionInput(const UBaseIndicatorViewModel& Indicator, FIndicatorProjectionInput& OutProjectionInput);
+
+	// Projects gathered input without touching any UObject, clamping it to the screen edge marker track if requested
+	bool ProjectInput(const FIndicatorProjectionInput& ProjectionInput, const FIndicatorProjectionView& View, const FVector2f& ScreenSize,
+		const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea, FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack, float& OutTrackArrowAngle,
+		FVector& OutWorldPosition);
+
+	// Same result as ULocalPlayer::GetPixelPoint, without recomputing the view projection matrix for every point.
+	// Points behind the camera return false, their position is mirrored so they can still be clamped to the correct screen edge.
+	bool ProjectWorldPoint(const FIndicatorProjectionView& View, const FVector& WorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenPosition);
+
+	// Moves the position toward the screen center until it lies on the screen edge marker track
+	void ClampToScreenEdgeMarkerTrack(FVector2D& InOutScreenPosition, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea,
+		float& OutTrackArrowAngle);
+
 	FBox GetBoundingBoxFromCapsule(UCapsuleComponent* Capsule);
 	FBox GetBoundingBoxFromMesh(const USkeletalMeshComponent* MeshComponent);
 
 	bool IsInsideScreenEdgeMarkerTrack(const FVector2D& ScreenPosition, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea);
 
-	bool ProjectActorRoot(const FSceneViewProjectionData& InProjectionData, const FVector& ProjectWorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition);
+	bool ProjectActorRoot(const FIndicatorProjectionView& View, const FVector& ProjectWorldLocation, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition);
 
-	bool ProjectActorScreenBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor,
+	bool ProjectActorScreenBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor,
 		const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition);
 
-	bool ProjectActorBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
+	bool ProjectActorBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
 		const FVector& WorldPositionOffset, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition);
 
-	bool ProjectSkeletalMeshBoundingBox(const FSceneViewProjectionData& InProjectionData, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
+	bool ProjectSkeletalMeshBoundingBox(const FIndicatorProjectionView& View, const FBox& BoundingBox, const FVector& BoundingBoxAnchor, const FVector& Center,
 		const FVector& WorldPositionOffset, const FVector2f& ScreenSize, FVector2D& OutScreenSpacePosition);
 }
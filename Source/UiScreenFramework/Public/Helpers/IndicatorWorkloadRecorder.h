@@ -0,0 +1,26 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "Structs/IndicatorProjectionInput.h"
+
+struct FSceneViewProjectionData;
+struct FScreenEdgeMarkersTrackArea;
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Records the indicator workload of a match, the view and the projection input of every visible indicator per canvas update,
+ * so it can be replayed and profiled without the level. See the UiScreenFramework.Indicators.Record and Replay console commands.
+ */
+namespace IndicatorWorkloadRecorder
+{
+	// True while a recording is running
+	bool IsRecording();
+
+	// Starts a new recorded frame, indicators recorded until the next call belong to it
+	void RecordFrame(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& ScreenEdgeMarkersTrackArea);
+
+	// Records the projection input of an indicator and its projected result, the replay verifies it reproduces the result
+	void RecordIndicator(const FIndicatorProjectionInput& ProjectionInput, const bool bProjected, const FVector2D& ScreenPosition, const bool bIsOnTheTrack);
+}
+#endif
@@ -5,10 +5,14 @@
 #include "DeveloperSettings/UiScreenFrameworkSettings.h"
 
 class UScreenViewModel;
+struct FUiScreenInfo;
 
 namespace UiScreenManagerHelper
 {
 	FGameplayTag GetCurrentScreenTag(const UObject* WorldContextObject);
 	TObjectPtr<UScreenViewModel> GetCurrentScreenViewModel(const UObject* WorldContextObject);
 	const UUiScreenFrameworkSettings& GetUiScreenFrameworkSettings();
+
+	// Appends the screen class, view model class and declared dependencies of the screen
+	void GatherScreenAssetPaths(const FUiScreenInfo& ScreenInfo, TArray<FSoftObjectPath>& OutAssetPaths);
 }
@@ -0,0 +1,27 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+
+namespace UiStreamingHelper
+{
+	// Load priorities of the framework, assets the user is waiting on are streamed before speculative ones
+	inline constexpr TAsyncLoadPriority InteractiveScreenPriority = FStreamableManager::AsyncLoadHighPriority;
+	inline constexpr TAsyncLoadPriority PrefetchPriority = 50;
+	inline constexpr TAsyncLoadPriority IndicatorPriority = 25;
+	inline constexpr TAsyncLoadPriority IndicatorPreloadPriority = FStreamableManager::DefaultAsyncLoadPriority;
+
+	static_assert(InteractiveScreenPriority > PrefetchPriority && PrefetchPriority > IndicatorPriority && IndicatorPriority > IndicatorPreloadPriority,
+		"Interactive screens have to be streamed before prefetches, prefetches before indicators");
+
+	// Cancels the handle if it's still loading, releases it otherwise. The handle is reset afterward.
+	void CancelOrReleaseHandle(TSharedPtr<FStreamableHandle>& Handle);
+
+	// Best effort: requests the packages the handle still waits for again at the given priority. Whether packages already in flight
+	// are reprioritized depends on the async loader, and the handle keeps its own priority either way.
+	void RaiseLoadPriority(const FStreamableHandle& Handle, TAsyncLoadPriority Priority);
+
+	// Estimates memory needed to load the assets from the on-disk size of their packages and hard dependencies that aren't loaded yet
+	int64 EstimateLoadSizeBytes(const TArray<FSoftObjectPath>& AssetPaths);
+}
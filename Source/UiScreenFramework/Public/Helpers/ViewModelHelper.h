@@ -11,4 +11,10 @@ namespace ViewModelHelper
 {
 	UMVVMView* GetMvvmViewExtensionFromWidget(const UUserWidget* Widget);
 	bool SetViewModel(const UUserWidget* Widget, UBaseViewModel* ViewModel);
+
+	// Uninitializes the MVVM bindings of the widget and its nested user widgets, so they stop processing field notifications
+	void SuspendBindings(const UUserWidget& Widget, TArray<TWeakObjectPtr<UMVVMView>>& OutSuspendedViews);
+
+	// Initializes the suspended bindings again, each binding runs once so the widgets catch up with all changes made meanwhile
+	void ResumeBindings(TArray<TWeakObjectPtr<UMVVMView>>& SuspendedViews);
 }
@@ -0,0 +1,42 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+/** Insights channel of the framework, enable it with -trace=cpu,uiscreenframework or Trace.Enable UiScreenFramework. */
+UE_TRACE_CHANNEL_EXTERN(UiScreenFrameworkChannel, UISCREENFRAMEWORK_API);
+
+/** CSV profiler category of the framework, mirrors the trace events and counters in CSV captures. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(UISCREENFRAMEWORK_API, UiScreenFramework);
+
+namespace UiScreenFrameworkTrace
+{
+	/** Returns true if the trace channel is enabled or a CSV capture is running, so event names are worth formatting. */
+	UISCREENFRAMEWORK_API bool IsEnabled();
+
+	/** Opens a region spanning several frames, like an async load or a layer transition. The name has to be unique while the region is open. */
+	UISCREENFRAMEWORK_API void BeginRegion(const FString& RegionName);
+	UISCREENFRAMEWORK_API void EndRegion(const FString& RegionName);
+
+	/** Instant event, shown as a bookmark in Insights and as an event in CSV captures. */
+	UISCREENFRAMEWORK_API void Event(const FString& EventText);
+}
+
+/** Timing scope with a static name, shown in the Insights timing view when the channel is enabled. */
+#define UI_SCREEN_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, UiScreenFrameworkChannel)
+
+/** Timing scope with a dynamic name, e.g. the class of the traced object. */
+#define UI_SCREEN_TRACE_SCOPE_TEXT(Name) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, UiScreenFrameworkChannel)
+
+/** Events and regions are only formatted when something records them. */
+#define UI_SCREEN_TRACE_EVENT(Format, ...) \
+	do { if (UiScreenFrameworkTrace::IsEnabled()) { UiScreenFrameworkTrace::Event(FString::Printf(Format, ##__VA_ARGS__)); } } while (0)
+#define UI_SCREEN_TRACE_BEGIN_REGION(Format, ...) \
+	do { if (UiScreenFrameworkTrace::IsEnabled()) { UiScreenFrameworkTrace::BeginRegion(FString::Printf(Format, ##__VA_ARGS__)); } } while (0)
+#define UI_SCREEN_TRACE_END_REGION(Format, ...) \
+	do { if (UiScreenFrameworkTrace::IsEnabled()) { UiScreenFrameworkTrace::EndRegion(FString::Printf(Format, ##__VA_ARGS__)); } } while (0)
@@ -0,0 +1,37 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enums/IndicatorLodRepresentation.h"
+#include "Styling/SlateBrush.h"
+
+#include "IndicatorLodEntry.generated.h"
+
+class UUserWidget;
+
+/**
+ * Single distance band of an indicator. Entries are expected to be ordered from the nearest to the farthest band.
+ */
+USTRUCT(BlueprintType)
+struct UISCREENFRAMEWORK_API FIndicatorLodEntry
+{
+	GENERATED_BODY()
+
+public:
+	// Representation is used while the distance from the camera is lower or equal to this value
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxDistance = 2000.f;
+
+	// How the indicator is displayed in this band
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EIndicatorLodRepresentation Representation = EIndicatorLodRepresentation::Widget;
+
+	// Widget displayed in this band
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "Representation == EIndicatorLodRepresentation::Widget", EditConditionHides))
+	TSoftClassPtr<UUserWidget> WidgetClass;
+
+	// Brush drawn in this band
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "Representation == EIndicatorLodRepresentation::Brush", EditConditionHides))
+	FSlateBrush Brush;
+};
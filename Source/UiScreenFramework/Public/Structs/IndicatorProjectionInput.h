@@ -0,0 +1,38 @@
+// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enums/IndicatorProjectionMode.h"
+
+/**
+ * Everything the projection of a single indicator needs, gathered from its view model, config and attached actor.
+ * Projecting it doesn't touch any UObject, so it can be recorded and replayed without the level.
+ */
+struct FIndicatorProjectionInput
+{
+	EIndicatorProjectionMode ProjectionMode = EIndicatorProjectionMode::ActorBoundingBox;
+
+	/** Bounds of the attached actor, unused for fixed point indicators. */
+	FBox BoundingBox = FBox(ForceInit);
+
+	/** Projected point of the root and bounding box modes, the fixed world position for fixed point indicators. */
+	FVector Center = FVector::ZeroVector;
+
+	FVector WorldPositionOffset = FVector::ZeroVector;
+	FVector BoundingBoxAnchor = FVector(0.5);
+	FVector2D ScreenSpaceOffset = FVector2D::ZeroVector;
+	bool bClampToScreen = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FIndicatorProjectionInput& Input)
+	{
+		Ar << Input.ProjectionMode;
+		Ar << Input.BoundingBox;
+		Ar << Input.Center;
+		Ar << Input.WorldPositionOffset;
+		Ar << Input.BoundingBoxAnchor;
+		Ar << Input.ScreenSpaceOffset;
+		Ar << Input.bClampToScreen;
+		return Ar;
+	}
+};
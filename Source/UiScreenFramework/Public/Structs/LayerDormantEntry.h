@@ -0,0 +1,23 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "Templates/SubclassOf.h"
+
+#include "LayerDormantEntry.generated.h"
+
+class SWidget;
+class UCommonActivatableWidget;
+
+USTRUCT()
+struct FLayerDormantEntry
+{
+	GENERATED_BODY()
+
+	/* Class of the widget released from the stack entry, an instance is restored when the entry is displayed again. */
+	UPROPERTY(Transient)
+	TSubclassOf<UCommonActivatableWidget> WidgetClass;
+
+	/* Empty content holding the switcher slot of the entry while it's dormant. */
+	TSharedPtr<SWidget> StandInWidget;
+};
@@ -0,0 +1,33 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "Components/SlateWrapperTypes.h"
+
+#include "LayerKeepAliveEntry.generated.h"
+
+class SWidget;
+class UCommonActivatableWidget;
+class UMVVMView;
+
+USTRUCT()
+struct FLayerKeepAliveEntry
+{
+	GENERATED_BODY()
+
+	/* Deactivated screen widget kept out of the pool. */
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonActivatableWidget> Widget;
+
+	/* Keeps the Slate tree of the widget alive while it's not in the switcher. */
+	TSharedPtr<SWidget> SlateWidget;
+
+	/* Visibility to restore when the widget is reused. */
+	ESlateVisibility PreviousVisibility = ESlateVisibility::Visible;
+
+	/* Estimated memory held by the widget and its Slate tree. */
+	int64 EstimatedSizeBytes = 0;
+
+	/* MVVM views uninitialized while the widget is retained, initialized again when it's reused. */
+	TArray<TWeakObjectPtr<UMVVMView>> SuspendedViews;
+};
@@ -0,0 +1,27 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Engine/StreamableManager.h"
+
+/**
+ * @brief Screen change applied to the screen history and broadcasted once the widget of the screen exists.
+ * Incrementally constructed screens keep it pending until their construction completes.
+ */
+struct FUiScreenChange
+{
+	/** Screen becoming current. */
+	FGameplayTag ScreenTag;
+
+	/** Screen that was current when the change was displayed, reported to the screen change listeners. */
+	FGameplayTag PreviousScreenTag;
+
+	/** Screens of coalesced or superseded changes, added to the history as if they had been displayed. */
+	TArray<FGameplayTag> SkippedScreens;
+
+	/** Handle of the screen's request, kept by the manager while the screen is current. */
+	TSharedPtr<FStreamableHandle> StreamingHandle;
+
+	bool bCleanUpExistingScreens = false;
+};
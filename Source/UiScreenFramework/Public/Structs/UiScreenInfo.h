@@ -29,4 +29,20 @@ struct FUiScreenInfo
 	// Main view model class
 	UPROPERTY(EditDefaultsOnly)
 	TSoftClassPtr<UScreenViewModel> ScreenViewModelClass;
+
+	// Screens that are likely to be opened next, prefetched while this screen is idle
+	UPROPERTY(EditDefaultsOnly, meta = (Categories = "UI.Screen"))
+	TArray<FGameplayTag> LikelyNextScreens;
+
+	// Additional assets required by the screen, streamed together with its classes
+	UPROPERTY(EditDefaultsOnly)
+	TArray<FSoftObjectPath> Dependencies;
+
+	// Constructs the screen widget over several frames within the construction budget, for heavy screens
+	UPROPERTY(EditDefaultsOnly)
+	bool bConstructIncrementally = false;
+
+	// The screen covers the whole viewport with opaque content, lower layers are suspended while it's displayed
+	UPROPERTY(EditDefaultsOnly)
+	bool bIsOpaqueFullscreen = false;
 };
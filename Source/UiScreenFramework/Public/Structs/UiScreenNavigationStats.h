@@ -0,0 +1,131 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+/**
+ * @brief Timestamps of the stages of a single screen navigation, in FPlatformTime::Seconds.
+ * Stages that weren't reached stay 0.
+ */
+struct FUiScreenNavigationTiming
+{
+	/** Screen the navigation targets. */
+	FGameplayTag ScreenTag;
+
+	double RequestTime = 0.0;
+	double LoadStartTime = 0.0;
+	double LoadCompleteTime = 0.0;
+	double ViewModelCreatedTime = 0.0;
+	double ViewModelReadyTime = 0.0;
+	double TransitionStartTime = 0.0;
+	double WidgetConstructedTime = 0.0;
+	double ActivatedTime = 0.0;
+
+	/** Milliseconds between two stages, 0 if either of them wasn't reached. */
+	static double GetStageMs(const double FromTime, const double ToTime)
+	{
+		return FromTime > 0.0 && ToTime >= FromTime ? (ToTime - FromTime) * 1000.0 : 0.0;
+	}
+
+	double GetTotalMs() const { return GetStageMs(RequestTime, ActivatedTime); }
+	double GetLoadMs() const { return GetStageMs(LoadStartTime, LoadCompleteTime); }
+	double GetViewModelMs() const { return GetStageMs(LoadCompleteTime, ViewModelReadyTime); }
+	double GetConstructionMs() const { return GetStageMs(ViewModelReadyTime, WidgetConstructedTime); }
+	double GetActivationMs() const { return GetStageMs(WidgetConstructedTime, ActivatedTime); }
+};
+
+/**
+ * @brief Stage durations of a single navigation, in milliseconds.
+ */
+struct FUiScreenNavigationSample
+{
+	double TotalMs = 0.0;
+	double LoadMs = 0.0;
+	double ViewModelMs = 0.0;
+	double ConstructionMs = 0.0;
+	double ActivationMs = 0.0;
+};
+
+/**
+ * @brief Navigation statistics of a single screen.
+ * Mean, p95 and the stage breakdown are computed over the most recent navigations, count and max over all of them.
+ */
+struct FUiScreenNavigationStats
+{
+	/** Number of navigations kept for the rolling mean, p95 and stage breakdown. */
+	static constexpr int32 MaxRecentSamples = 64;
+
+	int32 Count = 0;
+	double MaxMs = 0.0;
+
+	/** Ring buffer of the most recent navigations. */
+	TArray<FUiScreenNavigationSample> RecentSamples;
+	int32 NextSampleIndex = 0;
+
+#if STATS
+	/** Per-screen counters of the UiScreenFramework stat group, created with the first navigation to the screen. */
+	TStatId MeanStatId;
+	TStatId P95StatId;
+#endif
+
+	void AddSample(const FUiScreenNavigationTiming& Timing)
+	{
+		FUiScreenNavigationSample Sample;
+		Sample.TotalMs = Timing.GetTotalMs();
+		Sample.LoadMs = Timing.GetLoadMs();
+		Sample.ViewModelMs = Timing.GetViewModelMs();
+		Sample.ConstructionMs = Timing.GetConstructionMs();
+		Sample.ActivationMs = Timing.GetActivationMs();
+
+		++Count;
+		MaxMs = FMath::Max(MaxMs, Sample.TotalMs);
+
+		if (RecentSamples.Num() < MaxRecentSamples)
+		{
+			RecentSamples.Add(Sample);
+		}
+		else
+		{
+			RecentSamples[NextSampleIndex] = Sample;
+		}
+		NextSampleIndex = (NextSampleIndex + 1) % MaxRecentSamples;
+	}
+
+	/** Mean of a stage of the recent navigations, e.g. GetMeanStageMs(&FUiScreenNavigationSample::LoadMs). */
+	double GetMeanStageMs(double FUiScreenNavigationSample::* Stage) const
+	{
+		if (RecentSamples.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		double SumMs = 0.0;
+		for (const FUiScreenNavigationSample& Sample : RecentSamples)
+		{
+			SumMs += Sample.*Stage;
+		}
+		return SumMs / RecentSamples.Num();
+	}
+
+	double GetMeanMs() const { return GetMeanStageMs(&FUiScreenNavigationSample::TotalMs); }
+
+	/** Nearest-rank percentile of the recent navigations, Percentile is in [0, 1]. */
+	double GetPercentileMs(const double Percentile) const
+	{
+		if (RecentSamples.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		TArray<double> SortedTotalsMs;
+		SortedTotalsMs.Reserve(RecentSamples.Num());
+		for (const FUiScreenNavigationSample& Sample : RecentSamples)
+		{
+			SortedTotalsMs.Add(Sample.TotalMs);
+		}
+		SortedTotalsMs.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedTotalsMs.Num()) - 1, 0, SortedTotalsMs.Num() - 1);
+		return SortedTotalsMs[Rank];
+	}
+};
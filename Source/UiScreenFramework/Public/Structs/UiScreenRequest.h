@@ -0,0 +1,65 @@
+﻿// Copyright People Can Fly. All Rights Reserved."
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "Structs/ScreenInitialData.h"
+#include "Structs/UiScreenNavigationStats.h"
+
+class UScreenViewModel;
+
+/**
+ * @brief Screen change request moved through the UiScreenManager pipeline.
+ * Pending requests targeting the same or a higher layer are coalesced into the newest one.
+ * Remaining requests load concurrently and are displayed in request order.
+ */
+struct FUiScreenRequest
+{
+	/** Unique id of the request, passed to the streaming callbacks instead of the request itself. */
+	uint32 RequestId = 0;
+
+	/** Data passed to ChangeUiScreen, moved along with the request. */
+	FScreenInitialData InitialData;
+
+	/** Screens of the coalesced requests, in request order. They are added to the history as if they had been displayed. */
+	TArray<FGameplayTag> SkippedScreens;
+
+	/** Handle streaming the screen assets of this request. */
+	TSharedPtr<FStreamableHandle> StreamingHandle;
+
+	/** Indicates whether streaming of the screen assets has been started. */
+	bool bLoadStarted = false;
+
+	/** Indicates whether the screen assets are loaded and the request can be displayed. */
+	bool bAssetsLoaded = false;
+
+	/** Indicates whether the screen view model has been created or reused for this request. */
+	bool bViewModelPrepared = false;
+
+	/** Indicates whether the asynchronous initialization of the view model finished or timed out. */
+	bool bViewModelReady = false;
+
+	/** View model whose asynchronous initialization the request waits for, created by this request or reused before it was ready. */
+	TWeakObjectPtr<UScreenViewModel> AwaitedViewModel;
+
+	/** Real time ticker displaying the screen even if its view model isn't ready in time, it isn't affected by pause or time dilation. */
+	FTSTicker::FDelegateHandle ViewModelReadyTickerHandle;
+
+	/** Indicates whether the layout already transitions away from the current screen while the assets load. */
+	bool bOutgoingTransitionStarted = false;
+
+	/** Timestamps of the navigation stages, recorded into the navigation stats once the screen is activated. */
+	FUiScreenNavigationTiming Timing;
+
+	FUiScreenRequest() = default;
+
+	FUiScreenRequest(const uint32 InRequestId, FScreenInitialData&& InInitialData)
+		: RequestId(InRequestId)
+		  , InitialData(MoveTemp(InInitialData))
+	{
+		Timing.ScreenTag = InitialData.ScreenTag;
+		Timing.RequestTime = FPlatformTime::Seconds();
+	}
+};
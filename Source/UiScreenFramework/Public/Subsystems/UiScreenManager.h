@@ -3,16 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
-#include "Containers/Queue.h"
 #include "Engine/StreamableManager.h"
+#include "Engine/TimerHandle.h"
 #include "Structs/MainLayoutWidgetInfo.h"
 #include "Structs/ScreenInitialData.h"
+#include "Structs/UiScreenChange.h"
+#include "Structs/UiScreenNavigationStats.h"
+#include "Structs/UiScreenRequest.h"
 #include "Structs/UiScreenState.h"
 #include "Subsystems/LocalPlayerSubsystem.h"
 #include "UiScreenManager.generated.h"
 
 struct FUiScreenInfo;
+class UUiScreensData;
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnUiScreenChanged, const FGameplayTag /* Previous Screen Tag */, const FGameplayTag /* Current Screen Tag */);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUiScreenChanged_BP, const FGameplayTag, PreviousScreenTag, const FGameplayTag, CurrentScreenTag);
@@ -44,21 +49,17 @@ public:
 	/**
 	 * @brief Initializes the manager with the current player controller.
 	 * This creates the main layout widget and prepares the manager for use.
+	 * If the layout class is still streaming, the layout is created once the warm-up loads it.
 	 * @param PlayerController The owning player controller.
 	 */
 	void InitializeUiScreenManager(APlayerController* PlayerController);
 
-	/**
-	 * @brief Callback executed after a screen's widget class has been asynchronously loaded.
-	 * Proceeds with displaying the screen.
-	 * @param ScreenInitialData The initial data for the screen to be displayed.
-	 */
-	void OnScreenWidgetClassLoaded(FScreenInitialData ScreenInitialData);
-
 	/**
 	 * @brief Changes the active UI screen to the one specified by the tag inside Initial data struct.
 	 * This is the primary method for navigating between UI screens.
-	 * @param ScreenInitialData Data required to initialize the new screen.
+	 * Requests made before the warm-up finishes are queued. Requests on different layers load concurrently
+	 * and are displayed in request order, superseded requests are coalesced so only the final target per layer is displayed.
+	 * @param ScreenInitialData Data required to initialize the new screen, moved into the request.
 	 */
 	void ChangeUiScreen(FScreenInitialData ScreenInitialData);
 
@@ -70,13 +71,20 @@ public:
 
 	/**
 	 * @brief Retrieves the configuration info for a given screen tag from the UI Screens Data asset.
+	 * Uses the lookup table built on initialization, so no asset loading or linear search happens here.
 	 * @param ScreenTag The tag of the screen to find.
 	 * @return A pointer to the screen info struct, or nullptr if not found.
 	 */
 	FUiScreenInfo* GetUiScreenInfo(const FGameplayTag ScreenTag);
 
+	/** Returns true once the warm-up finished and the main layout widget exists, so screen changes can be processed. */
+	bool IsReadyForScreenChanges() const;
+
 	/** Gets the current UI screen state, including the active screen tag and history. */
 	const FUiScreenState& GetCurrentUiScreenData() const { return CurrentScreenState; }
+
+	/** Gets the screen whose widget is being displayed, ahead of the current screen while an incremental construction is pending. */
+	FGameplayTag GetDisplayingScreenTag() const { return PendingScreenChange ? PendingScreenChange->ScreenTag : CurrentScreenState.ScreenId; }
 	/** Gets information about the main layout widget, such as the widget instance and player owner. */
 	const FMainLayoutWidgetInfo& GetMainLayoutWidgetInfo() const { return MainLayoutWidgetInfo; }
 
@@ -91,10 +99,38 @@ public:
 	UCommonActivatableWidget* GetScreenWidget() const;
 
 	/**
-	 * @brief Executes the initialization callback for a newly created screen widget.
+	 * @brief Executes the initialization callback registered for the layer of a newly displayed screen widget.
 	 * @param ScreenWidget The screen widget instance to be initialized.
+	 * @param LayerId The layer the widget is displayed on.
+	 */
+	void CallInitializeScreenWidgetCallback(UCommonActivatableWidget* ScreenWidget, const FGameplayTag LayerId);
+
+	/** Stamps the construction of the screen a pending navigation waits for, once its layer added the widget. */
+	void OnLayerWidgetAdded(UCommonActivatableWidget& AddedWidget, const FGameplayTag LayerId);
+
+	/** Gets the navigation statistics of all screens navigated to so far, keyed by their screen tag. */
+	const TMap<FGameplayTag, FUiScreenNavigationStats>& GetNavigationStats() const { return NavigationStats; }
+
+	/**
+	 * @brief Logs the navigation statistics of all screens.
+	 * @param bWriteCsv If true, they are also written to a CSV file under the profiling directory.
+	 */
+	void DumpNavigationStats(const bool bWriteCsv) const;
+
+	/** Clears the navigation statistics of all screens. */
+	void ResetNavigationStats();
+
+#if !UE_BUILD_SHIPPING
+	/** Returns true when no screen request is pending and no layer transitions or constructs a screen. */
+	bool IsNavigationIdle() const;
+
+	/**
+	 * @brief Replaces the UI Screens Data asset from settings, used by the navigation performance test.
+	 * Pending requests, displayed screens, the history and view models refer to the previous asset, so they are torn down synchronously first.
+	 * @param InScreensData The data asset to use, nullptr restores the one from settings.
 	 */
-	void CallInitializeScreenWidgetCallback(UCommonActivatableWidget* ScreenWidget);
+	void SetScreensDataOverride(UUiScreensData* InScreensData);
+#endif
 
 	/** Delegate broadcasted when the UI screen changes. */
 	FOnUiScreenChanged OnUiScreenChanged;
@@ -135,32 +171,253 @@ protected:
 private:
 	/**
 	 * @brief Updates the current screen state and manages the screen history stack.
-	 * @param ScreenInitialData The initial data for the new screen.
+	 * Screens skipped by coalescing are pushed to the history first, as if they had been displayed.
+	 * @param ScreenChange The change to the new screen.
 	 * @param FoundViewInfo Information about the new screen being set.
 	 */
-	void SetCurrentScreenState(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo);
+	void SetCurrentScreenState(const FUiScreenChange& ScreenChange, const FUiScreenInfo& FoundViewInfo);
+
+	/** Applies the pending screen change to the history, updates the prefetches and broadcasts it. */
+	void CommitPendingScreenChange();
+
+	/** Screen change waiting for the incremental construction of its widget, unset once it's committed. */
+	TOptional<FUiScreenChange> PendingScreenChange;
+
+	/**
+	 * @brief Makes the given screen current and updates the history stack the same way a single screen change would.
+	 * @param ScreenId The screen becoming current.
+	 * @param bCleanUpExistingScreens If true, the history is cleared first.
+	 */
+	void AdvanceScreenHistory(const FGameplayTag ScreenId, const bool bCleanUpExistingScreens);
+
+	/**
+	 * @brief Adds the request to the pending list, dropping pending requests it supersedes and cancelling their loads.
+	 * A cleanup request supersedes all of them, otherwise requests on the same or a higher layer are dropped.
+	 * The cleanup flag and the skipped screens of the dropped requests are merged into the new one.
+	 */
+	void EnqueueScreenRequest(FUiScreenRequest&& ScreenRequest);
+
+	/** Returns false, logging why, if the screen is unknown, has no screen class or is already current without a cleanup. */
+	bool ValidateScreenRequest(const FScreenInitialData& ScreenInitialData);
+
+	/** Returns the index of the layer the screen is displayed on, INDEX_NONE if it's not known yet. */
+	int32 GetLayerIndexForScreen(const FGameplayTag ScreenTag);
+
+	/**
+	 * @brief Validates the request and starts streaming its assets, if they aren't resident already.
+	 * @return False if the request is invalid and should be dropped.
+	 */
+	bool StartScreenRequest(const uint32 RequestId);
+
+	/** Re-coalesces requests queued during the warm-up, starts their loads and displays the ones that are ready. */
+	void ProcessPendingScreenRequests();
+
+	/** Displays loaded requests in request order, stops at the first one that's still loading or whose view model isn't ready. */
+	void DisplayLoadedScreenRequests();
+
+	/**
+	 * @brief Starts the outgoing transition for the next request while its assets are still loading.
+	 * The screen swaps in once both the transition and the load finish. Placeholders are removed once no request is pending.
+	 */
+	void BeginOutgoingTransitionForNextRequest();
+
+	/** Returns true if any request is waiting for its assets. */
+	bool IsScreenRequestInFlight() const { return !PendingScreenRequests.IsEmpty(); }
+
+	/** Cancels the loads of all pending requests and removes them. */
+	void CancelPendingScreenRequests();
+
+	/** Finds a pending request by its id. */
+	FUiScreenRequest* FindPendingScreenRequest(const uint32 RequestId);
+
+	/**
+	 * @brief Callback executed after a screen's widget class, view model class and dependencies have been asynchronously loaded.
+	 * @param RequestId Id of the request the assets were loaded for.
+	 */
+	void OnScreenRequestAssetsLoaded(const uint32 RequestId);
+
+	/**
+	 * @brief Displays the screen of the request, its assets have to be loaded already.
+	 * No synchronous loads are performed here.
+	 */
+	void DisplayScreenRequest(FUiScreenRequest&& ScreenRequest);
 
 	/**
 	 * @brief Creates a new view model for a screen or reuses an existing one.
 	 * @param ScreenInitialData The initial data for the screen.
 	 * @param FoundViewInfo Information about the screen for which to create the view model.
+	 * @return The view model if it was created by this call, nullptr if it was reused or couldn't be created.
+	 */
+	UScreenViewModel* CreateOrReuseScreenViewModel(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo);
+
+	/**
+	 * @brief Creates or reuses the view model of the request and starts the asynchronous initialization of a new one.
+	 * The request is displayed once the view model is ready or the ready timeout passes.
+	 */
+	void PrepareScreenViewModel(FUiScreenRequest& ScreenRequest);
+
+	/**
+	 * @brief Called when the view model of the request finished its asynchronous initialization or didn't finish it in time.
+	 * @param RequestId Id of the request waiting for the view model.
+	 * @param bTimedOut True if the ready timeout passed.
 	 */
-	void CreateOrReuseScreenViewModel(const FScreenInitialData& ScreenInitialData, const FUiScreenInfo& FoundViewInfo);
+	void OnScreenViewModelReady(const uint32 RequestId, const bool bTimedOut);
 
-	/** Cleans up all cached screen view models. */
+	/** Makes the request wait for the asynchronous initialization of the view model, at most for the ready timeout in real time. */
+	void AwaitScreenViewModel(FUiScreenRequest& ScreenRequest, UScreenViewModel& ScreenViewModel);
+
+	/** Marks every pending request waiting for the view model ready, once its asynchronous initialization has been committed. */
+	void OnScreenViewModelInitialized(const UScreenViewModel* ScreenViewModel);
+
+	/** Cleans up all cached screen view models, their deinitialization is deferred. */
 	void CleanupAllScreenViewModels();
 
+	/**
+	 * @brief Removes the view model from use and queues its deinitialization.
+	 * The queue is processed after layer transitions finish, within the per-frame teardown budget.
+	 * @param ScreenTag The screen the view model belongs to.
+	 * @param ScreenViewModel The view model to deinitialize.
+	 */
+	void DeferScreenViewModelDeinit(const FGameplayTag ScreenTag, UScreenViewModel* ScreenViewModel);
+
+	/** Deinitializes the queued view model of the screen right away, so it never overlaps a new instance of the same screen. */
+	void FlushDeferredScreenViewModelDeinit(const FGameplayTag ScreenTag);
+
+	/** Ticker callback deinitializing queued view models within the budget, returns false once the queue is empty. */
+	bool ProcessDeferredTeardown(float DeltaTime);
+
+	/** Deinitializes all queued view models immediately. */
+	void FlushDeferredTeardown();
+
+	/**
+	 * @brief Evicts view models of the oldest screens in the history until the retention budget is met.
+	 * Evicted view models are snapshotted and deinitialized, screens that are still displayed on lower layers or stacked in a layer are kept.
+	 */
+	void EnforceViewModelRetention();
+
+	/** Adds the timing of a completed navigation to the stats of its screen and warns if it exceeded the navigation budget. */
+	void RecordNavigation(const FUiScreenNavigationTiming& Timing);
+
 	/** Broadcasts the OnUiScreenChanged and OnUiScreenChanged_BP delegates. */
 	void BroadcastScreenChange(const FGameplayTag PreviousScreenTag, const FGameplayTag CurrentScreenTag) const;
 
-	/** Handle for asynchronous asset streaming. */
-	TSharedPtr<FStreamableHandle> StreamingHandle;
+	/**
+	 * @brief Starts the asynchronous warm-up.
+	 * Streams the layout widget class and the UI Screens Data asset in parallel, startup screens follow as soon as the data asset is available.
+	 */
+	void StartWarmUp();
+
+	/** Called when the layout widget class finished streaming. Creates the layout if the player controller is already known. */
+	void OnLayoutWidgetClassLoaded();
+
+	/** Called when the UI Screens Data asset finished streaming. Builds the lookup table and streams the startup screens. */
+	void OnScreensDataLoaded();
+
+	/** Streams the screen and view model classes of the startup screens defined in settings. */
+	void LoadStartupScreens();
+
+	/** Processes all screen changes queued during the warm-up once the manager is ready for them, not only the first one. */
+	void TryProcessQueuedScreens();
+
+	/** Schedules prefetching of the current screen's likely next screens once it stays idle for the configured delay. */
+	void SchedulePrefetchForCurrentScreen();
+
+	/** Streams the likely next screens of the current screen within the count and memory budget. */
+	void PrefetchLikelyNextScreens();
+
+	/** Measures the prefetched assets and releases them if they don't fit in the memory budget. */
+	void OnScreenPrefetched(const FGameplayTag PrefetchedScreenTag);
+
+	/** Releases prefetched screens that aren't likely to be opened from the given screen. */
+	void ReleaseStalePrefetches(const FUiScreenInfo& NewScreenInfo);
+
+	/** Reports time from the warm-up start to the first frame with an interactive screen. */
+	void ReportFirstInteractiveFrame();
+
+	/**
+	 * @brief Resolves the UI Screens Data asset from settings and builds the screen tag lookup table.
+	 * In editor it's called again whenever the asset or the settings change.
+	 */
+	void BuildScreenInfoLookup();
+
+#if WITH_EDITOR
+	void OnScreensDataChanged(const UUiScreensData* ChangedScreensData);
+	void OnFrameworkSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent);
+#endif
+
+	/** Handles keeping the warm-up assets loaded. */
+	TSharedPtr<FStreamableHandle> LayoutWidgetClassHandle;
+	TSharedPtr<FStreamableHandle> ScreensDataHandle;
+	TSharedPtr<FStreamableHandle> StartupScreensHandle;
+
+	/** Prefetched screen assets kept in memory while they are likely to be opened next. */
+	struct FPrefetchedScreen
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int64 SizeBytes = 0;
+	};
+
+	/** Prefetched screens keyed by their screen tag. */
+	TMap<FGameplayTag, FPrefetchedScreen> PrefetchedScreens;
+
+	/** Handle keeping the assets of the current screen loaded, taken over from its request or prefetch. */
+	TSharedPtr<FStreamableHandle> DisplayedScreenHandle;
+
+	/** Total size of the prefetches, estimated while they load and measured once they complete. */
+	int64 PrefetchedBytes = 0;
+
+	/** Timer waiting for the current screen to become idle before prefetching. */
+	FTimerHandle PrefetchTimerHandle;
+
+	/** Player controller for which the layout should be created once its class is loaded. */
+	TWeakObjectPtr<APlayerController> PendingLayoutPlayerController;
+
+	/** Time at which the warm-up started, used to report time-to-first-interactive-frame. */
+	double WarmUpStartTime = 0.0;
+
+	bool bLayoutWidgetClassReady = false;
+	bool bScreensDataReady = false;
+	bool bWarmUpFinished = false;
+	bool bFirstInteractiveFrameReported = false;
+
+	/** Screen change requests that haven't been displayed yet, in request order and coalesced per layer. Each one streams its own assets. */
+	TArray<FUiScreenRequest> PendingScreenRequests;
+
+	/** Id assigned to the next screen request. */
+	uint32 NextScreenRequestId = 1;
+
+	/** Callback functions to initialize the screen widget after it's created, keyed by layer so concurrent changes don't overwrite each other. */
+	TMap<FGameplayTag, TFunction<void(UCommonActivatableWidget*)>> InitializeScreenWidgetCallbacks;
+
+	/** Timings of displayed navigations waiting for their screen to be activated, keyed by layer. */
+	TMap<FGameplayTag, FUiScreenNavigationTiming> ActivationPendingTimings;
+
+	/** Navigation statistics keyed by screen tag. */
+	TMap<FGameplayTag, FUiScreenNavigationStats> NavigationStats;
+
+	/** The UI Screens Data asset resolved from settings on initialization. */
+	UPROPERTY(Transient)
+	TObjectPtr<UUiScreensData> ScreensData;
+
+#if !UE_BUILD_SHIPPING
+	/** Data asset used instead of the one from settings, kept alive by ScreensData. */
+	TWeakObjectPtr<UUiScreensData> ScreensDataOverride;
+#endif
+
+	/** Index into ScreensData->Screens for every screen tag. */
+	TMap<FGameplayTag, int32> ScreenInfoIndices;
+
+	/** Snapshots of evicted screen view models, keyed by their screen tag. */
+	TMap<FGameplayTag, TArray<uint8>> ScreenViewModelSnapshots;
+
+	/** View models of closed screens waiting for their deinitialization, keyed by their screen tag. */
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, TObjectPtr<UScreenViewModel>> ViewModelsPendingDeinit;
 
-	/** Queue for holding screen change requests that arrive while another is being processed. */
-	TQueue<FScreenInitialData> ScreensToDisplayQueue;
+	FTSTicker::FDelegateHandle DeferredTeardownTickerHandle;
 
-	/** Callback function to initialize the screen widget after it's created. */
-	TFunction<void(UCommonActivatableWidget*)> InitializeScreenWidgetCallback;
+	/** Set when a new view model was created for the current screen, its reused widget might still be bound to a previous instance. */
+	bool bRebindCurrentScreenWidget = false;
 
 	/** A map of all active screen view models, keyed by their screen tag. */
 	UPROPERTY(Transient)
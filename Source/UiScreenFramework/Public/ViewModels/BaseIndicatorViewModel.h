@@ -4,13 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "BaseViewModel.h"
-#include "Enums/IndicatorCategory.h"
-#include "Enums/IndicatorProjectionMode.h"
+#include "DataAssets/IndicatorConfigData.h"
 #include "Enums/IndicatorVisibilityPriority.h"
-#include "Types/SlateEnums.h"
 #include "BaseIndicatorViewModel.generated.h"
 
-class SWidget;
+class SBox;
 class UUserWidget;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBaseIndicatorViewModel, Log, All);
@@ -25,65 +23,63 @@ public:
 	{
 	};
 	virtual void Deinit() override;
+	virtual void PostLoad() override;
+
+	// Only clients display indicators
+	virtual bool NeedsLoadForServer() const override { return false; }
+
 	void SetIsIndicatorClamped(const bool bInIsIndicatorClamped) { UE_MVVM_SET_PROPERTY_VALUE(bIsIndicatorClamped, bInIsIndicatorClamped); }
 	void SetClampAngle(const float InClampAngle) { UE_MVVM_SET_PROPERTY_VALUE(ClampAngle, InClampAngle); }
 
 protected:
-	// Indicator category identifier
+	// Shared static configuration of the indicator, class defaults of UIndicatorConfigData are used when it is not set
 	UPROPERTY(EditAnywhere)
-	EIndicatorCategory IndicatorCategory = EIndicatorCategory::Default;
+	TObjectPtr<const UIndicatorConfigData> IndicatorConfig;
 
-	// Indicator user widget class
-	UPROPERTY(EditAnywhere)
-	TSoftClassPtr<UUserWidget> IndicatorWidgetClass;
+#if WITH_EDITORONLY_DATA
+	// Per view model settings saved before they moved to UIndicatorConfigData, migrated on load
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	EIndicatorCategory IndicatorCategory_DEPRECATED = EIndicatorCategory::Default;
 
-	// Indicator's Projection Mode on the screen
-	UPROPERTY(EditAnywhere)
-	EIndicatorProjectionMode ProjectionMode = EIndicatorProjectionMode::ActorBoundingBox;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	TSoftClassPtr<UUserWidget> IndicatorWidgetClass_DEPRECATED;
 
-	// Horizontal alignment 
-	UPROPERTY(EditAnywhere)
-	TEnumAsByte<EHorizontalAlignment> HAlignment = HAlign_Center;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	EIndicatorProjectionMode ProjectionMode_DEPRECATED = EIndicatorProjectionMode::ActorBoundingBox;
 
-	// Vertical alignment 
-	UPROPERTY(EditAnywhere)
-	TEnumAsByte<EVerticalAlignment> VAlignment = VAlign_Center;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	TEnumAsByte<EHorizontalAlignment> HAlignment_DEPRECATED = HAlign_Center;
 
-	// Anchor point for indicator that is located on its owner bounding box (default value is top of bounding box)
-	UPROPERTY(EditAnywhere)
-	FVector BoundingBoxAnchor = FVector(0.5f, 0.5f, 1.0f);
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	TEnumAsByte<EVerticalAlignment> VAlignment_DEPRECATED = VAlign_Center;
 
-	// Additional offset on screen space
-	UPROPERTY(EditAnywhere)
-	FVector2D ScreenSpaceOffset = FVector2D(0.0f, 0.0f);
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	FVector BoundingBoxAnchor_DEPRECATED = FVector(0.5f, 0.5f, 1.0f);
 
-	// Additional Offset in World (default value make indicator move up a little bit)
-	UPROPERTY(EditAnywhere)
-	FVector WorldPositionOffset = FVector(0.0f, 0.0f, 20.0f);
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	FVector2D ScreenSpaceOffset_DEPRECATED = FVector2D(0.0f, 0.0f);
 
-	// Time of transition between indicator's visibility modes
-	UPROPERTY(EditAnywhere)
-	float TransitionTime = .2f;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	FVector WorldPositionOffset_DEPRECATED = FVector(0.0f, 0.0f, 20.0f);
 
-	// Should indicator stay on screen if its owner is out of screen
-	UPROPERTY(EditAnywhere)
-	bool bClampToScreen = false;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	float TransitionTime_DEPRECATED = .2f;
 
-	// Indicates whether indicator should update the distance factor
-	UPROPERTY(EditAnywhere)
-	bool bUpdateDistance = false;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	bool bClampToScreen_DEPRECATED = false;
 
-	// Indicates whether indicator has distance visibility condition
-	UPROPERTY(EditAnywhere)
-	bool bHasVisibilityRange = false;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	bool bUpdateDistance_DEPRECATED = false;
 
-	// Indicates range when player starts seeing indicator
-	UPROPERTY(EditAnywhere, meta = (EditCondition = "bHasVisibilityRange || bUpdateDistance"))
-	float VisibilityRangeOuter = 1500.0f;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	bool bHasVisibilityRange_DEPRECATED = false;
 
-	// Indicates range when indicator is fully visible
-	UPROPERTY(EditAnywhere, meta = (EditCondition = "bHasVisibilityRange || bUpdateDistance"))
-	float VisibilityRangeInner = 1000.0f;
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	float VisibilityRangeOuter_DEPRECATED = 1500.0f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use IndicatorConfig instead"))
+	float VisibilityRangeInner_DEPRECATED = 1000.0f;
+#endif
 
 	// Indicates range when indicator is fully visible
 	UPROPERTY(BlueprintReadOnly, FieldNotify)
@@ -96,18 +92,33 @@ protected:
 public:
 	static float CalculateOuterDistanceFactor(float Distance, float OuterRange, float InnerRange);
 
-	EIndicatorCategory GetIndicatorCategory() const { return IndicatorCategory; }
+	// Returns index of the LOD entry for the given distance, LodEntries.Num() means the indicator is beyond the farthest band
+	static int32 SelectLodIndex(const TArray<FIndicatorLodEntry>& InLodEntries, int32 CurrentLodIndex, float Distance, float Hysteresis);
+
+	const UIndicatorConfigData& GetIndicatorConfig() const { return IndicatorConfig ? *IndicatorConfig : *GetDefault<UIndicatorConfigData>(); }
+
+	void SetIndicatorConfig(const UIndicatorConfigData* InIndicatorConfig);
+
+	EIndicatorCategory GetIndicatorCategory() const { return IndicatorCategoryOverride.Get(GetIndicatorConfig().IndicatorCategory); }
 
+	// Overrides the category of the shared config for this indicator only
 	void SetIndicatorCategory(EIndicatorCategory InIndicatorCategory);
 
 	bool GetIndicatorVisibility() const { return bVisibility; }
 
 	void SetIndicatorVisibility(bool bInVisibility, EIndicatorVisibilityPriority InPriority = EIndicatorVisibilityPriority::AlwaysAllowEnable);
 
-	TSoftClassPtr<UUserWidget> GetIndicatorClass() const { return IndicatorWidgetClass; }
+	TSoftClassPtr<UUserWidget> GetIndicatorClass() const { return IndicatorWidgetClassOverride.IsNull() ? GetIndicatorConfig().IndicatorWidgetClass : IndicatorWidgetClassOverride; }
 
+	// Overrides the widget class of the shared config for this indicator only
 	void SetIndicatorClass(TSoftClassPtr<UUserWidget> InIndicatorWidgetClass);
 
+	bool HasLods() const { return !GetIndicatorConfig().LodEntries.IsEmpty(); }
+
+	const TArray<FIndicatorLodEntry>& GetLodEntries() const { return GetIndicatorConfig().LodEntries; }
+
+	float GetLodHysteresis() const { return GetIndicatorConfig().LodHysteresis; }
+
 	virtual UUserWidget* GetIndicatorWidget();
 
 	TWeakObjectPtr<UUserWidget> IndicatorWidget;
@@ -115,56 +126,58 @@ public:
 	// Layout Properties
 	//=======================
 
-	EIndicatorProjectionMode GetProjectionMode() const { return ProjectionMode; }
+	// The setters below override the shared config for this indicator only, prefer configuring IndicatorConfig
+
+	EIndicatorProjectionMode GetProjectionMode() const { return ProjectionModeOverride.Get(GetIndicatorConfig().ProjectionMode); }
 
 	void SetProjectionMode(EIndicatorProjectionMode InProjectionMode);
 
 	// Horizontal alignment to the point in space to place the indicator at.
-	EHorizontalAlignment GetHAlign() const { return HAlignment; }
+	EHorizontalAlignment GetHAlign() const { return HAlignmentOverride.Get(GetIndicatorConfig().HAlignment); }
 
 	void SetHAlign(EHorizontalAlignment InHAlignment);
 
 	// Vertical alignment to the point in space to place the indicator at.
-	EVerticalAlignment GetVAlign() const { return VAlignment; }
+	EVerticalAlignment GetVAlign() const { return VAlignmentOverride.Get(GetIndicatorConfig().VAlignment); }
 
 	void SetVAlign(EVerticalAlignment InVAlignment);
 
 	// Clamp the indicator to the edge of the screen?
-	bool GetClampToScreen() const { return bClampToScreen; }
+	bool GetClampToScreen() const { return bClampToScreenOverride.Get(GetIndicatorConfig().bClampToScreen); }
 
 	void SetClampToScreen(bool bValue);
 
 	// The position offset for the indicator in world space.
-	FVector GetWorldPositionOffset() const { return WorldPositionOffset; }
+	FVector GetWorldPositionOffset() const { return WorldPositionOffsetOverride.Get(GetIndicatorConfig().WorldPositionOffset); }
 
 	void SetWorldPositionOffset(const FVector Offset);
 
 	// The position offset for the indicator in screen space.
-	FVector2D GetScreenSpaceOffset() const { return ScreenSpaceOffset; }
+	FVector2D GetScreenSpaceOffset() const { return ScreenSpaceOffsetOverride.Get(GetIndicatorConfig().ScreenSpaceOffset); }
 
 	void SetScreenSpaceOffset(const FVector2D Offset);
 
-	FVector GetBoundingBoxAnchor() const { return BoundingBoxAnchor; }
+	FVector GetBoundingBoxAnchor() const { return BoundingBoxAnchorOverride.Get(GetIndicatorConfig().BoundingBoxAnchor); }
 
 	void SetBoundingBoxAnchor(const FVector InBoundingBoxAnchor);
 
-	float GetTransitionTime() const { return TransitionTime; }
+	float GetTransitionTime() const { return TransitionTimeOverride.Get(GetIndicatorConfig().TransitionTime); }
 
 	void SetTransitionTime(float InTransitionTime);
 
-	bool GetHasVisibilityRange() const { return bHasVisibilityRange; }
+	bool GetHasVisibilityRange() const { return bHasVisibilityRangeOverride.Get(GetIndicatorConfig().bHasVisibilityRange); }
 
 	void SetHasVisibilityRange(bool bValue);
 
-	bool ShouldUpdateDistance() const { return bUpdateDistance; }
+	bool ShouldUpdateDistance() const { return bUpdateDistanceOverride.Get(GetIndicatorConfig().bUpdateDistance); }
 
 	void SetShouldUpdateDistance(const bool bValue);
 
-	float GetVisibilityRangeOuter() const { return VisibilityRangeOuter; }
+	float GetVisibilityRangeOuter() const { return VisibilityRangeOuterOverride.Get(GetIndicatorConfig().VisibilityRangeOuter); }
 
 	void SetVisibilityRangeOuter(float InVisibilityRangeOuter);
 
-	float GetVisibilityRangeInner() const { return VisibilityRangeInner; }
+	float GetVisibilityRangeInner() const { return VisibilityRangeInnerOverride.Get(GetIndicatorConfig().VisibilityRangeInner); }
 
 	void SetVisibilityRangeInner(float InVisibilityRangeInner);
 
@@ -191,6 +204,11 @@ public:
 	void UpdateDistanceFactor();
 
 private:
+#if WITH_EDITORONLY_DATA
+	// Moves settings saved on the view model itself into a config owned by it, so old assets keep their look
+	void MigrateDeprecatedConfig();
+#endif
+
 	bool IsPlayerWithinRange() const;
 	float GetDistanceFactor() const;
 	bool bVisibility = false;
@@ -199,14 +217,31 @@ private:
 
 	int32 Priority = 0;
 
+	// Per indicator overrides of the shared config, unset unless one of the setters was called
+	TOptional<EIndicatorCategory> IndicatorCategoryOverride;
+	TSoftClassPtr<UUserWidget> IndicatorWidgetClassOverride;
+	TOptional<EIndicatorProjectionMode> ProjectionModeOverride;
+	TOptional<EHorizontalAlignment> HAlignmentOverride;
+	TOptional<EVerticalAlignment> VAlignmentOverride;
+	TOptional<bool> bClampToScreenOverride;
+	TOptional<FVector> WorldPositionOffsetOverride;
+	TOptional<FVector2D> ScreenSpaceOffsetOverride;
+	TOptional<FVector> BoundingBoxAnchorOverride;
+	TOptional<float> TransitionTimeOverride;
+	TOptional<bool> bHasVisibilityRangeOverride;
+	TOptional<bool> bUpdateDistanceOverride;
+	TOptional<float> VisibilityRangeOuterOverride;
+	TOptional<float> VisibilityRangeInnerOverride;
+
 	friend class SIndicatorCanvas;
+	friend class UIndicatorComponent;
 
 	TWeakObjectPtr<AActor> ActorAttachedTo = nullptr;
 
 	UPROPERTY(Transient)
 	FVector FixedWorldPosition = FVector::ZeroVector;
 
-	TWeakPtr<SWidget> CanvasHost;
+	TWeakPtr<SBox> CanvasHost;
 
 	EIndicatorVisibilityPriority CurrentVisibilityPriority = EIndicatorVisibilityPriority::AlwaysAllowEnable;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "BaseViewModel.h"
 #include "UObject/Object.h"
 #include "ScreenViewModel.generated.h"
@@ -17,6 +18,37 @@ public:
 	virtual void Init();
 	virtual void Deinit() override;
 
+	/**
+	 * Starts the asynchronous part of the initialization. Called by the UiScreenManager after Init and the view model init callback, for newly created view models only.
+	 * Heavy work can run on worker threads, the screen is activated once the returned future is ready or the ready timeout passes.
+	 * Results have to be applied in CommitAsyncInit, which runs on the game thread. By default the view model is ready right away.
+	 */
+	virtual TFuture<void> InitAsync();
+
+	/** Called on the game thread once the future returned by InitAsync is ready. */
+	void CompleteAsyncInit();
+
+	/** Returns true once the asynchronous initialization has been committed. */
+	bool IsReady() const { return bIsReady; }
+
+	/** Serializes properties marked SaveGame into a compact snapshot, taken when the view model is evicted from the screen history. */
+	void SaveSnapshot(TArray<uint8>& OutSnapshot);
+
+	/** Restores properties from a snapshot taken with SaveSnapshot. Called after Init when going back to an evicted screen. */
+	void RestoreSnapshot(const TArray<uint8>& Snapshot);
+
+protected:
+	/** Called after the view model has been rehydrated from a snapshot, rebuild derived state and broadcast field changes here. */
+	virtual void OnRestoredFromSnapshot()
+	{
+	}
+
+	/** Applies results of the asynchronous initialization on the game thread, broadcast field changes here. */
+	virtual void CommitAsyncInit()
+	{
+	}
+
 private:
 	bool bHasBeenInit = false;
+	bool bIsReady = false;
 };
@@ -3,7 +3,11 @@
 #pragma once
 
 #include "Blueprint/UserWidgetPool.h"
+#include "Containers/Ticker.h"
 #include "Slate/SCommonAnimatedSwitcher.h"
+#include "Structs/LayerDormantEntry.h"
+#include "Structs/LayerKeepAliveEntry.h"
+#include "UObject/ObjectKey.h"
 #include "LayerWidget.generated.h"
 
 class SCommonAnimatedSwitcher;
@@ -11,6 +15,8 @@ enum class ECommonSwitcherTransition : uint8;
 enum class ETransitionCurve : uint8;
 
 class UCommonActivatableWidget;
+class UMVVMView;
+class SInvalidationPanel;
 class SOverlay;
 class SSpacer;
 
@@ -61,14 +67,58 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * Same as AddWidget, but a new instance is created, built and prepassed over several frames within the per-frame construction budget.
+	 * It's added to the container once complete, the displayed widget stays active meanwhile. Retained instances are added right away.
+	 * Adding or clearing widgets cancels the construction.
+	 */
+	void AddWidgetIncrementally(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+
+	/** Returns true while a widget is being constructed incrementally. */
+	bool IsConstructingWidget() const { return IncrementalConstructionPhase != EIncrementalConstructionPhase::None; }
+
 	void RemoveWidget(UCommonActivatableWidget& WidgetToRemove);
 
+	/**
+	 * Adds an empty slot on top and transitions to it, so the displayed widget transitions out while the next one is loading.
+	 * The next added widget takes over the slot instead of starting another transition.
+	 */
+	void ShowPlaceholder();
+
+	/** Removes the placeholder slot, transitioning back to the widget below it if the placeholder is displayed. */
+	void RemovePlaceholder();
+
+	/**
+	 * Suspends the layer while an opaque fullscreen screen above covers it.
+	 * It's collapsed, so its widgets are neither ticked nor painted, and the MVVM bindings of its screens stop processing field notifications.
+	 * Resuming restores the visibility and runs every binding once, so the screens catch up with all changes made meanwhile.
+	 */
+	void SetSuspended(const bool bInSuspended);
+
+	bool IsSuspended() const { return bSuspended; }
+
 	UFUNCTION(BlueprintCallable, Category = ActivatableWidgetStack)
 	UCommonActivatableWidget* GetActiveWidget() const;
 
+	/**
+	 * Widgets of the layer in the switcher order, the widget at index i is in switcher slot i + 1.
+	 * Dormant stack entries keep their place as null entries, so the indices match GetNumWidgets.
+	 */
 	const TArray<UCommonActivatableWidget*>& GetWidgetList() const { return WidgetList; }
 
+	/** Constructed widgets of the layer in the switcher order, dormant stack entries are skipped. */
+	TArray<UCommonActivatableWidget*> GetLiveWidgets() const;
+
+	/** Returns the switcher index of the first widget of the given class in the layer, or INDEX_NONE if there's none. */
+	int32 FindSwitcherIndexForClass(const UClass* WidgetClass) const;
+
+	/** Returns true if a constructed widget of the given class is in the layer, dormant stack entries don't count. */
+	bool HasLiveWidgetOfClass(const UClass* WidgetClass) const;
+
 	int32 GetNumWidgets() const;
+
+	/** Returns true while the switcher plays a transition between widgets. */
+	bool IsTransitioning() const;
 	void SetSwitcherIndex(int32 TargetIndex, bool bInstantTransition = false);
 
 	UFUNCTION(BlueprintCallable, Category = ActivatableWidgetContainer)
@@ -84,6 +134,11 @@ public:
 
 	FOnDisplayedWidgetChanged& OnDisplayedWidgetChanged() const { return OnDisplayedWidgetChangedEvent; }
 
+	DECLARE_EVENT_OneParam(ULayerWidget, FOnWidgetAdded, UCommonActivatableWidget&);
+
+	/** Broadcast when a widget is added to the layer, once its construction completed (incrementally constructed ones included). */
+	FOnWidgetAdded& OnWidgetAdded() const { return OnWidgetAddedEvent; }
+
 	DECLARE_EVENT_TwoParams(UCommonActivatableWidgetContainerBase, FTransitioningChanged, ULayerWidget* /*Widget*/, bool /*bIsTransitioning*/);
 
 	FTransitioningChanged OnTransitioningChanged;
@@ -95,6 +150,23 @@ protected:
 
 	virtual void OnWidgetAddedToList(UCommonActivatableWidget& AddedWidget) { unimplemented(); }
 
+	/** Called once the widget in the active slot is displayed and activated, after the slots above it were released. */
+	virtual void OnActiveIndexChanged(int32 ActiveWidgetIndex) {}
+
+	/**
+	 * Releases the widget of the slot to the keep-alive cache with its MVVM bindings uninitialized and leaves an empty stand-in in the slot.
+	 * Returns false if the slot doesn't hold a widget that can go dormant, like the displayed one.
+	 */
+	bool MakeEntryDormant(const int32 SlotIndex);
+
+	/** Puts a widget of the dormant entry back into its slot, reusing a retained instance if there's one. */
+	void RestoreDormantEntry(const int32 SlotIndex);
+
+	bool IsEntryDormant(const int32 SlotIndex) const;
+
+	/** Puts the widget into the placeholder slot, returns false if there's no placeholder. */
+	bool ReplacePlaceholder(UCommonActivatableWidget& AddedWidget);
+
 	/** The type of transition to play between widgets */
 	UPROPERTY(EditAnywhere, Category = Transition)
 	ECommonSwitcherTransition TransitionType;
@@ -114,33 +186,161 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Transition)
 	ECommonSwitcherTransitionFallbackStrategy TransitionFallbackStrategy = ECommonSwitcherTransitionFallbackStrategy::None;
 
+	/**
+	 * Number of recently removed widgets kept with their Slate tree alive, so reopening them doesn't rebuild it.
+	 * 0 releases removed widgets to the pool right away.
+	 */
+	UPROPERTY(EditAnywhere, Category = KeepAlive, meta = (ClampMin = 0))
+	int32 KeepAliveCacheSize = 2;
+
+	/** Estimated memory budget of the kept alive widgets, least recently used ones are released first when it's exceeded. */
+	UPROPERTY(EditAnywhere, Category = KeepAlive, meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 KeepAliveMemoryBudgetKB = 8 * 1024;
+
+	/**
+	 * Hosts the layer content inside an invalidation panel, so a static screen is cached and costs close to nothing per frame.
+	 * Caching is paused while the layer transitions and the cache is invalidated when the displayed screen changes.
+	 * With global invalidation enabled the panel doesn't cache on its own and the layer relies on it instead.
+	 */
+	UPROPERTY(EditAnywhere, Category = Performance)
+	bool bUseInvalidationPanel = false;
+
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UCommonActivatableWidget>> WidgetList;
 
+	/** Index in the widget list of the first widget of each class, dormant stack entries included. */
+	TMap<TObjectKey<UClass>, int32> WidgetListIndexByClass;
+
+	/** Number of constructed widgets of each class in the widget list, dormant stack entries don't count. */
+	TMap<TObjectKey<UClass>, int32> NumLiveWidgetsByClass;
+
+	/** Stack entries whose widget was released, their slots hold an empty stand-in until they're displayed again. */
+	UPROPERTY(Transient)
+	TArray<FLayerDormantEntry> DormantEntries;
+
 	UPROPERTY(Transient)
 	TObjectPtr<UCommonActivatableWidget> DisplayedWidget;
 
 	UPROPERTY(Transient)
 	FUserWidgetPool GeneratedWidgetsPool;
 
+	/** Recently removed widgets with their Slate tree retained, most recently used first. */
+	UPROPERTY(Transient)
+	TArray<FLayerKeepAliveEntry> KeepAliveCache;
+
+	/** Widgets waiting to be released to the pool, their Slate trees are destroyed within the per-frame teardown budget. */
+	UPROPERTY(Transient)
+	TArray<FLayerKeepAliveEntry> PendingReleaseWidgets;
+
+	/** Widget being constructed incrementally, it's not in the widget list until complete. */
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonActivatableWidget> IncrementalWidget;
+
+	UPROPERTY(Transient)
+	TSubclassOf<UCommonActivatableWidget> IncrementalWidgetClass;
+
+	/** User widgets nested in the incremental widget whose Slate tree isn't built yet, innermost first. */
+	TArray<TWeakObjectPtr<UUserWidget>> IncrementalNestedWidgets;
+
 	TSharedPtr<SOverlay> MyOverlay;
 	TSharedPtr<SSpacer> MyInputGuard;
 	TSharedPtr<SCommonAnimatedSwitcher> MySwitcher;
+	TSharedPtr<SInvalidationPanel> MyInvalidationPanel;
+
+	/** Empty content of the placeholder slot, valid while the layer waits for the next widget. */
+	TSharedPtr<SWidget> PlaceholderWidget;
+
+	/** False once the layer switched to another slot, the placeholder is then released when the switcher lands there. */
+	bool bPlaceholderIsSwitcherTarget = false;
 
 private:
 	UCommonActivatableWidget* AddWidgetInternal(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass, TFunctionRef<void(UCommonActivatableWidget&)> InitFunc);
 	void RegisterInstanceInternal(UCommonActivatableWidget& NewWidget);
 
+	/** Removes the widget from the widget list and reindexes the widgets that followed it. */
+	void RemoveFromWidgetList(UCommonActivatableWidget& Widget);
+
+	/** Removes the entry from the widget list, its switcher slot has to be still in place. Only the class of the entry and the following indices are updated. */
+	void RemoveWidgetListEntry(const int32 WidgetListIndex);
+
+	/** Class of the widget list entry, the class of the released widget for dormant stack entries. */
+	const UClass* GetWidgetListEntryClass(const int32 WidgetListIndex) const;
+
+	void AddLiveWidgetOfClass(const UClass* WidgetClass, const int32 Delta);
+
+	/** Gets an instance from the pool, pool hits and misses are reported to the trace and CSV profiler. */
+	UCommonActivatableWidget* GetOrCreatePooledInstance(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+
+	/** Takes a retained instance of the class if there's one, otherwise gets one from the pool. */
+	UCommonActivatableWidget* TakeOrCreateInstance(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+
+	int32 FindDormantEntryIndex(const TSharedPtr<SWidget>& SlateWidget) const;
+
+	/** Sets the visibility of the layer, while suspended it's applied once the layer resumes. */
+	void SetLayerVisibility(const ESlateVisibility InVisibility);
+
 	void HandleSwitcherIsTransitioningChanged(bool bIsTransitioning);
 	void HandleActiveIndexChanged(int32 ActiveWidgetIndex);
 	void HandleActiveWidgetDeactivated(UCommonActivatableWidget* DeactivatedWidget);
 
 	void ReleaseWidget(const TSharedRef<SWidget>& WidgetToRelease);
+
+	/** Moves the widget to the keep-alive cache, or queues its release if the cache is disabled. */
+	void RetainOrReleaseWidget(UCommonActivatableWidget& ActivatableWidget, const TSharedRef<SWidget>& SlateWidget, const bool bSuspendBindings = false);
+	/** Takes a retained widget of the given class out of the keep-alive cache or the pending releases. */
+	UCommonActivatableWidget* TakeRetainedWidget(TArray<FLayerKeepAliveEntry>& RetainedWidgets, TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+	/** Queues least recently used widgets for release until the cache fits in its count and memory budget. */
+	void TrimKeepAliveCache(const int32 MaxEntries);
+
+	/** Queues the widget for release, the release happens after the transition within the per-frame teardown budget. */
+	void QueueWidgetRelease(FLayerKeepAliveEntry&& Entry);
+	/** Drops the Slate tree of the widget and releases it to the pool. */
+	void ReleaseRetainedWidget(FLayerKeepAliveEntry&& Entry);
+	/** Ticker callback releasing queued widgets within the budget, returns false once the queue is empty. */
+	bool ProcessPendingWidgetReleases(float DeltaTime);
+	/** Releases all queued widgets immediately. */
+	void FlushPendingWidgetReleases();
+
+	FTSTicker::FDelegateHandle PendingReleaseTickerHandle;
+
+	/** Runs the next step of the incremental construction. */
+	void AdvanceIncrementalConstruction();
+	/** Ticker callback running construction steps within the budget, returns false once the construction is complete. */
+	bool ProcessIncrementalConstruction(float DeltaTime);
+	/** Stops the incremental construction and releases the partially constructed widget. */
+	void CancelIncrementalConstruction();
+
+	FTSTicker::FDelegateHandle IncrementalConstructionTickerHandle;
+
+	/** Steps of the incremental construction, each one runs within a single frame. */
+	enum class EIncrementalConstructionPhase : uint8
+	{
+		None,
+		CreateWidget,
+		BuildNestedSlate,
+		BuildSlate,
+		Prepass
+	};
+
+	EIncrementalConstructionPhase IncrementalConstructionPhase = EIncrementalConstructionPhase::None;
+
 	TArray<TSharedPtr<SWidget>> ReleasedWidgets;
 
+	/** Instances the pool has handed out, to tell pool hits from misses. The pool holds them until the Slate resources are released, the set is reset then. */
+	TSet<TObjectKey<UCommonActivatableWidget>> PooledWidgetKeys;
+
 	bool bRemoveDisplayedWidgetPostTransition = false;
 
+	bool bSuspended = false;
+
+	/** Visibility to restore once the layer resumes. */
+	ESlateVisibility VisibilityBeforeSuspension = ESlateVisibility::Collapsed;
+
+	/** MVVM views whose bindings were uninitialized by the suspension. */
+	TArray<TWeakObjectPtr<UMVVMView>> SuspendedViews;
+
 	mutable FOnDisplayedWidgetChanged OnDisplayedWidgetChangedEvent;
+	mutable FOnWidgetAdded OnWidgetAddedEvent;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -165,8 +365,17 @@ public:
 protected:
 	virtual void SynchronizeProperties() override;
 	virtual void OnWidgetAddedToList(UCommonActivatableWidget& AddedWidget) override;
+	virtual void OnActiveIndexChanged(int32 ActiveWidgetIndex) override;
 
 private:
+	/**
+	 * Maximum number of stack entries with a live widget, 0 keeps all of them live.
+	 * The lowest entries beyond it go dormant, their widgets are released and rebuilt or restored from the keep-alive cache when popped back to,
+	 * so deep stacks don't keep every Slate tree resident.
+	 */
+	UPROPERTY(EditAnywhere, Category = Performance, meta = (ClampMin = 0))
+	int32 MaxLiveStackEntries = 0;
+
 	/** Optional widget to auto-generate as the permanent root element of the stack */
 	UPROPERTY(EditAnywhere, Category = Content)
 	TSubclassOf<UCommonActivatableWidget> RootContentWidgetClass;
@@ -14,8 +14,16 @@ class UOverlay;
 /**
  * @brief Delegate that is broadcast whenever the currently displayed widget changes.
  * @param CurrentScreenWidget A pointer to the newly displayed activatable widget.
+ * @param LayerId The layer on which the widget is displayed.
  */
-DECLARE_DELEGATE_OneParam(FOnDisplayedWidgetChanged, UCommonActivatableWidget* /* Current Screen Widget */);
+DECLARE_DELEGATE_TwoParams(FOnDisplayedWidgetChanged, UCommonActivatableWidget* /* Current Screen Widget */, const FGameplayTag /* Layer Id */);
+
+/**
+ * @brief Delegate that is broadcast whenever a layer added a widget, once its construction completed.
+ * @param AddedWidget The widget the layer added.
+ * @param LayerId The layer that added the widget.
+ */
+DECLARE_DELEGATE_TwoParams(FOnLayerWidgetAdded, UCommonActivatableWidget& /* Added Widget */, const FGameplayTag /* Layer Id */);
 
 
 /**
@@ -37,6 +45,25 @@ public:
 	 */
 	ULayerWidget* GetLayerForScreenInfo(const FUiScreenInfo& UiScreenInfo);
 
+	/**
+	 * @brief Gets the Z-order index of the layer, index 0 is the bottom-most layer.
+	 * @param LayerId The tag of the layer.
+	 * @return The index of the layer, or INDEX_NONE if it's not registered.
+	 */
+	int32 GetLayerIndex(const FGameplayTag LayerId) const;
+
+	/** Returns true while any of the registered layers plays a transition. */
+	bool IsAnyLayerTransitioning() const;
+
+	/** Returns true while any of the registered layers constructs a screen incrementally. */
+	bool IsAnyLayerConstructing() const;
+
+	/** Returns true if any of the registered layers holds a constructed widget of the class, displayed or stacked. */
+	bool HasLiveWidgetOfClass(const UClass* WidgetClass) const;
+
+	/** Removes the screens of all registered layers. */
+	void ClearAllLayers();
+
 	/**
 	 * @brief Checks if a widget of the same class as the one in UiScreenInfo already exists in the target layer and, if so, switches to it.
 	 * @param UiScreenInfo The information about the screen to potentially switch to.
@@ -52,6 +79,17 @@ public:
 	 */
 	void SetWidgetForLayer(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens);
 
+	/**
+	 * @brief Transitions away from the current screens while the given screen is still loading.
+	 * Higher layers (or all of them on cleanup) are cleared, the target layer transitions to a placeholder that's replaced by the screen once it's added.
+	 * @param UiScreenInfo The information about the screen that's going to be displayed.
+	 * @param bCleanUpExistingScreens If true, all existing screens on all layers are removed.
+	 */
+	void BeginOutgoingTransition(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens);
+
+	/** Removes placeholders of all layers, transitioning them back to their previous screens. */
+	void RemoveLayerPlaceholders();
+
 	/**
 	 * @brief Gets the dedicated overlay widget for displaying tooltips.
 	 * @return A pointer to the tooltip layer overlay.
@@ -73,6 +111,9 @@ public:
 	/** Delegate broadcasted when the displayed widget changes, used by UiScreenManager. */
 	FOnDisplayedWidgetChanged OnDisplayedWidgetChangedDelegate;
 
+	/** Delegate broadcasted when a layer added a widget, used by UiScreenManager. */
+	FOnLayerWidgetAdded OnWidgetAddedDelegate;
+
 protected:
 	/**
 	 * @brief Overridden from UUserWidget. Cleans up bindings when the widget is destroyed.
@@ -83,8 +124,12 @@ protected:
 	 * @brief Handles the OnDisplayedWidgetChanged event from a ULayerWidget.
 	 * Caches the current screen widget and broadcasts the main delegate.
 	 * @param CommonActivatableWidget The new widget that is being displayed.
+	 * @param LayerId The layer that broadcasted the change.
 	 */
-	void OnDisplayedWidgetChanged(UCommonActivatableWidget* CommonActivatableWidget);
+	void OnDisplayedWidgetChanged(UCommonActivatableWidget* CommonActivatableWidget, const FGameplayTag LayerId);
+
+	/** Handles the OnWidgetAdded event from a ULayerWidget and broadcasts the main delegate. */
+	void OnLayerWidgetAdded(UCommonActivatableWidget& AddedWidget, const FGameplayTag LayerId);
 	
 	/**
 	 * @brief Adds and registers a new UI layer. Layers should be registered in their Z-order, from bottom to top.
@@ -111,12 +156,32 @@ private:
 	UPROPERTY(Transient)
 	TArray<FLayerInfo> Layers;
 
+	/** Index in Layers of each registered layer. */
+	TMap<FGameplayTag, int32> LayerIndexById;
+
 	/**
 	 * @brief Cached tooltip layer widget. This is a simple UOverlay where tooltips are rendered.
 	 */
 	UPROPERTY(Transient)
 	TObjectPtr<UOverlay> TooltipLayer;
 
+	/**
+	 * @brief Tracks the opaque fullscreen screen that's going to be displayed, lower layers are resumed if the change uncovers them.
+	 * @param UiScreenInfo The information about the screen that's going to be displayed.
+	 * @param bCleanUpExistingScreens If true, all existing screens on all layers are removed.
+	 */
+	void UpdateOpaqueScreen(const FUiScreenInfo& UiScreenInfo, const bool bCleanUpExistingScreens);
+
+	/** Suspends all layers below the given one and resumes the others, INDEX_NONE resumes all of them. */
+	void SuspendLayersBelow(const int32 LayerIndex);
+
 	/** A weak pointer to the currently active screen widget. */
 	TWeakObjectPtr<UCommonActivatableWidget> CurrentScreenWidget;
+
+	/** Index of the layer displaying or about to display an opaque fullscreen screen, INDEX_NONE if there's none. */
+	int32 OpaqueScreenLayerIndex = INDEX_NONE;
+
+	/** Class of that opaque fullscreen screen, the layers below are suspended once it's displayed. */
+	UPROPERTY(Transient)
+	TSubclassOf<UCommonActivatableWidget> OpaqueScreenClass;
 };
\ No newline at end of file
@@ -14,7 +14,12 @@
 #include "Blueprint/UserWidgetPool.h"
 
 class FArrangedChildren;
+class SBox;
+class SImage;
 class SIndicatorCanvas;
+struct FStreamableHandle;
+struct FIndicatorProjectionInput;
+struct FSceneViewProjectionData;
 class UIndicatorManagerSubsystem;;
 
 class SIndicatorCanvas : public SPanel
@@ -41,6 +46,7 @@ public:
 			  , bDirty(true)
 			  , bWasIndicatorClamped(false)
 			  , bWasIndicatorClampedStatusChanged(false)
+			  , bLodHidden(InIndicator && InIndicator->HasLods())
 		{
 		}
 
@@ -114,6 +120,19 @@ public:
 			RefreshVisibility();
 		}
 
+		bool IsLodHidden() const { return bLodHidden; }
+
+		void SetLodHidden(bool bInLodHidden)
+		{
+			if (bLodHidden != bInLodHidden)
+			{
+				bLodHidden = bInLodHidden;
+				bDirty = true;
+			}
+
+			RefreshVisibility();
+		}
+
 		bool bIsDirty() const { return bDirty; }
 
 		void ClearDirtyFlag()
@@ -165,6 +184,23 @@ public:
 		mutable uint8 bWasIndicatorClamped : 1;
 		mutable uint8 bWasIndicatorClampedStatusChanged : 1;
 
+		/** Whether the current distance band hides the indicator (or no band has been selected yet) */
+		uint8 bLodHidden : 1;
+
+		/** Index of the LOD entry currently displayed, INDEX_NONE until the first distance update */
+		int32 LodIndex = INDEX_NONE;
+
+		/** LOD entry waiting for its widget class to be streamed in, the current representation stays until it is loaded */
+		int32 PendingLodIndex = INDEX_NONE;
+		TSharedPtr<FStreamableHandle> PendingLodHandle;
+
+		/** Image of the brush bands, kept across band changes, showing a copy of the brush so config edits can't leave it dangling */
+		TSharedPtr<SImage> LodImage;
+		FSlateBrush LodBrush;
+
+		/** Widget classes of the neighbouring bands this indicator keeps preloaded */
+		TArray<FSoftObjectPath, TInlineAllocator<2>> PreloadedLodPaths;
+
 		friend class SIndicatorCanvas;
 	};
 
@@ -199,6 +235,18 @@ public:
 
 	void SetDrawElementsInOrder(bool bInDrawElementsInOrder) { bDrawElementsInOrder = bInDrawElementsInOrder; }
 
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Runs a recorded frame through the canvas update, with the recorded projection inputs instead of the indicator actors.
+	 * Creates a replay indicator per input on demand, so only canvases created for UiScreenFramework.Indicators.Replay can use it.
+	 */
+	void ReplayFrame(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, const FScreenEdgeMarkersTrackArea& InScreenEdgeMarkersTrackArea,
+		TConstArrayView<FIndicatorProjectionInput> ProjectionInputs, float InDeltaTime);
+
+	/** Result of the replay indicator of the given input in the last replayed frame, false if it couldn't be projected */
+	bool GetReplayedIndicator(int32 Index, FVector2D& OutScreenPosition, bool& bOutIsOnTheTrack) const;
+#endif
+
 private:
 	void OnIndicatorAdded(UBaseIndicatorViewModel* Indicator);
 	void OnIndicatorRemoved(UBaseIndicatorViewModel* IndicatorViewModel);
@@ -214,6 +262,10 @@ private:
 	void OnIndicatorVisibilityChanged(int32 NewIndicatorVisibilityOption);
 	EActiveTimerReturnType UpdateCanvas(double InCurrentTime, float InDeltaTime);
 
+	/** Projects and updates the slots of all visible indicators, returns whether any of them changed. GatherInput provides the projection input of a slot */
+	bool UpdateIndicators(const FSceneViewProjectionData& ProjectionData, const FVector2f& ScreenSize, float InDeltaTime,
+		TFunctionRef<bool(int32 ChildIndex, const UBaseIndicatorViewModel& IndicatorViewModel, FIndicatorProjectionInput& OutProjectionInput)> GatherInput);
+
 	void GetOffsetAndSize(const UBaseIndicatorViewModel* IndicatorViewModel,
 		FVector2D& OutSize,
 		FVector2D& OutOffset,
@@ -222,10 +274,31 @@ private:
 
 	void UpdateActiveTimer();
 
+	/** Selects the distance band for the indicator and swaps its representation when the band changes */
+	void UpdateIndicatorLod(FSlot& IndicatorSlot, UBaseIndicatorViewModel& IndicatorViewModel, float Distance);
+	void ApplyIndicatorLod(FSlot& IndicatorSlot, UBaseIndicatorViewModel& IndicatorViewModel, int32 LodIndex);
+	void OnLodWidgetClassLoaded(TWeakObjectPtr<UBaseIndicatorViewModel> IndicatorViewModelWeak, int32 LodIndex);
+
+	/** Streams in widget classes of the neighbouring bands so the next swap doesn't wait for a load */
+	void PreloadAdjacentLods(FSlot& IndicatorSlot, const UBaseIndicatorViewModel& IndicatorViewModel, int32 LodIndex);
+
+	/** Drops the preloads of the indicator, the widget classes are released once no other indicator preloads them */
+	void ReleaseLodPreloads(FSlot& IndicatorSlot);
+
+	/** Replaces the widget bound to the indicator, the previous one goes back to the pool */
+	void SetIndicatorWidget(UBaseIndicatorViewModel& IndicatorViewModel, UUserWidget* NewIndicatorWidget);
+
+	FSlot* FindSlotForIndicator(const UBaseIndicatorViewModel* IndicatorViewModel);
+
 private:
 	TArray<TObjectPtr<UBaseIndicatorViewModel>> AllIndicators;
 	TArray<TObjectPtr<UBaseIndicatorViewModel>> InactiveIndicators;
 
+#if !UE_BUILD_SHIPPING
+	/** Indicators standing in for the recorded ones of a replayed workload, in the order of the recorded inputs */
+	TArray<TObjectPtr<UBaseIndicatorViewModel>> ReplayIndicators;
+#endif
+
 	FLocalPlayerContext LocalPlayerContext;
 	TWeakObjectPtr<UIndicatorManagerSubsystem> IndicatorManager;
 
@@ -237,6 +310,20 @@ private:
 
 	FUserWidgetPool IndicatorPool;
 
+	struct FLodPreload
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+
+		/** Indicators whose neighbouring bands use the widget class */
+		int32 NumReferences = 0;
+	};
+
+	/** Keeps widget classes of neighbouring LOD bands resident while indicators are in an adjacent band */
+	TMap<FSoftObjectPath, FLodPreload> LodPreloads;
+
+	/** Widget class loads of indicators waiting for their slot, cancelled when the indicator is removed first */
+	TMap<TWeakObjectPtr<UBaseIndicatorViewModel>, TSharedPtr<FStreamableHandle>> PendingIndicatorLoads;
+
 	/** Whether to draw elements in the order they were added to canvas. Note: Enabling this will disable batching and will cause a greater number of drawcalls */
 	bool bDrawElementsInOrder = false;
 